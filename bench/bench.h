@@ -0,0 +1,339 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#ifndef RDSPARSER_BENCH_H
+#define RDSPARSER_BENCH_H
+#include <stdio.h>
+#include <stdlib.h>
+#include <librdsparser.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* Real-world capture (same as in examples/main.c) */
+static const char *bench_capture[] =
+{
+    "A20120017420696E02",
+    "A201E0153475A20313",
+    "A20130100064CD4615",
+    "A2018001D9F579E800",
+    "A2010019032B4F4500",
+    "A201200220D7313A00",
+    "A201E015067BA20318",
+    "A201001A2B5F203114",
+    "A2018001D9F579E801",
+    "A201001F1F2B202001",
+    "A201E0157907A20300",
+    "A2010018E703202000",
+    "A20120032044696500",
+    "A2018001D9F579E834",
+    "A2010019032B4F4500",
+    "A201E015640DA20300",
+    "A201001A0320203100",
+    "A20180014E91920000",
+    "A201001F035F202000",
+    "A201E015026AA20310",
+    "A2010018833120200C",
+    "A20120042066656D04",
+    "A2014001D758F84233",
+    "A20180014E91920010",
+    "A2010019015F4F4511",
+    "A2012005696E697321",
+    "A201E0153079A20314",
+    "A2013010580CCD463D",
+    "A20180014E91920004",
+    "A201001AE51E203100",
+    "A20120067469736300",
+    "A201E0152078A20300",
+    "A201001F1E5F202024",
+    "A2018002DE418CBE01",
+    "A2010018021E202000",
+    "A201E0151F8CA2031C",
+    "A2010019E5024F4502",
+    "A20120076865204200",
+    "A2018002DE418CBE00",
+    "A201001A025F203102",
+    "A201E0150F6AA20308",
+    "A201001F021E202002",
+    "A2018002DE418CBE14",
+    "A2010018E32220200C",
+    "A201E0155F13A20329",
+    "A2010019225F4F4500",
+    "A201200861726F6300",
+    "A20180025418EE9000",
+    "A201001AE921203100",
+    "A20120096B64696310",
+    "A201E0153A05A20300",
+    "A20130100064CD4600",
+    "A20180025418EE9000",
+    "A201001F215F202000",
+    "A201200A6874657200",
+    "A201E01D0000A20301",
+    "A20100181C21202000",
+    "A20180025418EE9000",
+    "A201001921314F4500",
+    "A201E0002020A21300",
+    "A201001A2123203102",
+    "A201200B696E205300",
+    "A20180020CA0000002",
+    "A201001FE51C202005",
+    "A201E001464DA21300",
+    "A20100181C21202002",
+    "A20180020CA0000001",
+    "A20100191C5F4F4500",
+    "A201E0023420A21304",
+    "A201001AE931203130",
+    "A201200C6962796C00",
+    "A20180020CA0000008",
+    "A201001F2131202000",
+    "A201200D6C61205310",
+    "A201E0032020A21310",
+    "A20130104000CD4612",
+    "A201800843F4A68735",
+    "A2010018315F202000",
+    "A201200E6368776100",
+    "A201E0055F71A21316",
+    "A201001925314F4524",
+    "A201800843F4A68704",
+    "A201001A3180203101",
+    "A201E0050192A21300",
+    "A201001FE90F202004",
+    "A201200F727A202000",
+    "A201800843F4A68708",
+    "A20100180F5F202011",
+    "A201E005348BA21300",
+    "A20100190F1E4F451A",
+    "A2018003C191BF2C20",
+    "A201001A0F23203127",
+    "A201E0052DA3A21304",
+    "A201001F0F32202001",
+    "A20120005269747A08",
+    "A2018003C191BF2C06",
+    "A2010018E51E202000",
+    "A20120017420696E00",
+    "A2013834F68DA2133C",
+    "A2018003C191BF2C09",
+    "A20100191E5F4F4514",
+    "A201200220D7313A00",
+    "A201E00564A5A21320",
+    "A201001A0F1E203100",
+    "A2018003415D2C8C04",
+    "A201001FF95F202001",
+    "A201E00D0001A21300",
+    "A20100182D5F202010",
+    "A2012003204469650C",
+    "A2018003415D2C8C3C",
+    "A20100195F644F4500",
+    "A20130100064CD4606",
+    "A201E0005241A60210",
+    "A201064A345F203122",
+    "A2018003415D2C8C0C",
+    "A201001F1E5F202000",
+    "A201E0014449A60214",
+    "A2010018225F202000",
+    "A20120042066656D00",
+    "A20180085065A0FC30",
+    "A2010019375F4F4504",
+    "A2012005696E697330",
+    "A201E62A492EA6022C",
+    "A20180085065A0FC00",
+    "A201001A305F203110",
+    "A2012006176F73630C",
+    "A201E0034E20A60201",
+    "A201001F3A5F20200C",
+    "A20180085065A14F3B",
+    "A20100180F5F202020",
+    "A201F9B5C754A60235",
+    "A2010019025F4F4501",
+    "A201200768C320422C",
+    "A2018004B87D8DB010",
+    "A201001A015F203101",
+    "A20130104000CD4603",
+    "A201E0051E39A602C0",
+    "A201001F215F202000",
+    "A201800488658DB000",
+    "A2010018F15F202020",
+    "A201E0051E3EA60204",
+    "A20100192B5F40872F",
+    "A201200861726F6300",
+    "A201800488658DB0D4",
+    "A201001A5F792031C0",
+    "A20120096B64696306",
+    "A201E0053452A60208",
+    "A20180045BA000002F",
+    "A201001F065F202000",
+    "A201200A6874657237",
+    "A201E005A47AA60204",
+    "A2010018265F202000",
+    "A2018004421000000D",
+    "A2010019395F4F4510",
+    "A201E0055F28A60200",
+    "A201001A035F203130",
+    "A201200B696E205304",
+    "A2018004A20800001C",
+    "A201001F1C5F202010",
+    "A201051B0064CD4634",
+    "A201E6062D68A6023E",
+    "A2010018315F202002",
+    "A20180058991C1E110",
+    "A2010019E5374F4543",
+    "A201E0053C4EA60204",
+    "A201001A2D37203100",
+    "A201200C6962796C00",
+    "A20180058991C1E100",
+    "A201001F375F202000",
+    "A201200D6C61205300",
+    "A201E005223FA60200",
+    "A20130104000CD4634",
+    "A20180058991C1E100",
+    "A2010018E330202030",
+    "A201200E6F6E440107",
+    "A201E0052661A6022C",
+    "A2010019305F4F451B",
+    "A20180054E96460000",
+    "A201001AE534203100",
+    "A201A0005445535400", // PTYN
+    "A201A0015445535400", // PTYN
+    "A2014001D750018200", // CT
+    "A201100000E0000000", // ECC
+};
+
+#define BENCH_CAPTURE_LENGTH (sizeof(bench_capture) / sizeof(bench_capture[0]))
+
+static inline double
+bench_now(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+static inline int
+bench_hex(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return 0;
+}
+
+static inline void
+bench_decode(const char        *input,
+             rdsparser_data_t   data,
+             rdsparser_error_t  errors)
+{
+    for (int block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+    {
+        data[block] = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            data[block] = (uint16_t)((data[block] << 4) | bench_hex(input[block * 4 + i]));
+        }
+    }
+
+    const int error_byte = (input[16] ? (bench_hex(input[16]) << 4 | bench_hex(input[17])) : 0);
+    errors[RDSPARSER_BLOCK_A] = (error_byte >> 6) & 3;
+    errors[RDSPARSER_BLOCK_B] = (error_byte >> 4) & 3;
+    errors[RDSPARSER_BLOCK_C] = (error_byte >> 2) & 3;
+    errors[RDSPARSER_BLOCK_D] = error_byte & 3;
+}
+
+/* Repeat the capture to fill the arrays */
+static inline void
+bench_load(rdsparser_data_t  *data,
+           rdsparser_error_t *errors,
+           size_t             count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        bench_decode(bench_capture[i % BENCH_CAPTURE_LENGTH], data[i], errors[i]);
+    }
+}
+
+#define BENCH_BLOCK_BITS 26
+#define BENCH_GROUP_BITS (RDSPARSER_BLOCK_COUNT * BENCH_BLOCK_BITS)
+
+static const uint16_t bench_offsets[RDSPARSER_BLOCK_COUNT] = { 0x0FC, 0x198, 0x168, 0x1B4 };
+
+static inline uint32_t
+bench_encode(uint16_t info,
+             uint16_t offset)
+{
+    uint32_t reg = (uint32_t)info << 10;
+    for (int bit = 25; bit >= 10; bit--)
+    {
+        if (reg & (1UL << bit))
+        {
+            reg ^= 0x5B9UL << (bit - 10);
+        }
+    }
+
+    return ((uint32_t)info << 10) | (reg ^ offset);
+}
+
+static inline void
+bench_put(uint8_t  *buffer,
+          size_t    position,
+          uint32_t  block)
+{
+    for (int i = BENCH_BLOCK_BITS - 1; i >= 0; i--, position++)
+    {
+        if ((block >> i) & 1)
+        {
+            buffer[position / 8] |= (uint8_t)(0x80 >> (position % 8));
+        }
+    }
+}
+
+/* Encode groups into a packed bitstream (MSB first) */
+static inline void
+bench_bitstream(uint8_t                *buffer,
+                const rdsparser_data_t *data,
+                size_t                  count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        for (int block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+        {
+            uint16_t offset = bench_offsets[block];
+            if (block == RDSPARSER_BLOCK_C && (data[i][RDSPARSER_BLOCK_B] & 0x0800))
+            {
+                offset = 0x350;
+            }
+            bench_put(buffer, i * BENCH_GROUP_BITS + block * BENCH_BLOCK_BITS, bench_encode(data[i][block], offset));
+        }
+    }
+}
+
+static inline void
+bench_report(const char *name,
+             size_t      count,
+             double      elapsed)
+{
+    printf("%-24s %10zu groups %9.3f ms %12.0f groups/s\n",
+           name, count, elapsed * 1e3, (double)count / elapsed);
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <librdsparser.h>
+#include "bench.h"
+
+#define BENCH_GROUPS 1000000
+#define BENCH_ROUNDS 5
+
+static void
+callback_ps(rdsparser_t *rds,
+            void        *user_data)
+{
+    (*(size_t*)user_data)++;
+}
+
+static rdsparser_t*
+bench_context(size_t *counter)
+{
+#ifdef RDSPARSER_DISABLE_HEAP
+    static rdsparser_t buffer;
+    rdsparser_t *rds = &buffer;
+#else
+    rdsparser_t *rds = rdsparser_new();
+#endif
+    rdsparser_init(rds);
+    rdsparser_set_text_correction(rds, RDSPARSER_TEXT_PS, RDSPARSER_BLOCK_TYPE_DATA, RDSPARSER_BLOCK_ERROR_LARGE);
+    rdsparser_set_text_progressive(rds, RDSPARSER_TEXT_PS, true);
+    rdsparser_set_user_data(rds, counter);
+    rdsparser_register_ps(rds, callback_ps);
+    return rds;
+}
+
+int
+main(void)
+{
+    rdsparser_data_t *data = malloc(sizeof(rdsparser_data_t) * BENCH_GROUPS);
+    rdsparser_error_t *errors = malloc(sizeof(rdsparser_error_t) * BENCH_GROUPS);
+    if (data == NULL || errors == NULL)
+    {
+        return -1;
+    }
+
+    bench_load(data, errors, BENCH_GROUPS);
+
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        size_t single_updates = 0;
+        rdsparser_t *rds = bench_context(&single_updates);
+        double start = bench_now();
+        for (size_t i = 0; i < BENCH_GROUPS; i++)
+        {
+            rdsparser_parse(rds, data[i], errors[i]);
+        }
+        bench_report("rdsparser_parse", BENCH_GROUPS, bench_now() - start);
+#ifndef RDSPARSER_DISABLE_HEAP
+        rdsparser_free(rds);
+#endif
+
+        size_t batch_updates = 0;
+        rds = bench_context(&batch_updates);
+        start = bench_now();
+        rdsparser_parse_batch(rds, (const rdsparser_data_t*)data, (const rdsparser_error_t*)errors, BENCH_GROUPS);
+        bench_report("rdsparser_parse_batch", BENCH_GROUPS, bench_now() - start);
+
+        if (single_updates != batch_updates)
+        {
+            fprintf(stderr, "Result mismatch: %zu != %zu\n", single_updates, batch_updates);
+            return -1;
+        }
+#ifndef RDSPARSER_DISABLE_HEAP
+        rdsparser_free(rds);
+#endif
+    }
+
+    free(data);
+    free(errors);
+    return 0;
+}
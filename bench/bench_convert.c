@@ -0,0 +1,135 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <librdsparser.h>
+#include "bench.h"
+
+#define BENCH_LINES 1000000
+#define BENCH_ROUNDS 5
+
+/* Copy of the former strtol-based converter, as a baseline */
+static bool
+bench_convert_strtol(const char        *input,
+                     rdsparser_data_t   data_out,
+                     rdsparser_error_t  errors_out)
+{
+    const size_t block_string_length = 4;
+    const size_t error_string_length = 2;
+
+    const size_t rds_len = RDSPARSER_BLOCK_COUNT * block_string_length;
+    const size_t input_len = strlen(input);
+    char *end;
+
+    if (input_len == rds_len)
+    {
+        errors_out[RDSPARSER_BLOCK_A] = 0;
+        errors_out[RDSPARSER_BLOCK_B] = 0;
+        errors_out[RDSPARSER_BLOCK_C] = 0;
+        errors_out[RDSPARSER_BLOCK_D] = 0;
+    }
+    else if (input_len == rds_len + error_string_length)
+    {
+        const char *ptr = input + RDSPARSER_BLOCK_COUNT * block_string_length;
+        uint8_t buffer = (uint8_t)strtol(ptr, &end, 16);
+
+        if (*end != '\0')
+        {
+            return false;
+        }
+
+        errors_out[RDSPARSER_BLOCK_A] = (buffer & 192) >> 6;
+        errors_out[RDSPARSER_BLOCK_B] = (buffer & 48) >> 4;
+        errors_out[RDSPARSER_BLOCK_C] = (buffer & 12) >> 2;
+        errors_out[RDSPARSER_BLOCK_D] = (buffer & 3);
+    }
+    else
+    {
+        return false;
+    }
+
+    for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+    {
+        char buffer[block_string_length + 1];
+        for (uint8_t i = 0; i < block_string_length; i++)
+        {
+            buffer[i] = input[block * block_string_length + i];
+        }
+
+        buffer[block_string_length] = '\0';
+        data_out[block] = (uint16_t)strtol(buffer, &end, 16);
+
+        if (*end != '\0')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int
+main(void)
+{
+    const char **lines = malloc(sizeof(char*) * BENCH_LINES);
+    rdsparser_data_t *data = malloc(sizeof(rdsparser_data_t) * BENCH_LINES);
+    rdsparser_error_t *errors = malloc(sizeof(rdsparser_error_t) * BENCH_LINES);
+    if (lines == NULL || data == NULL || errors == NULL)
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < BENCH_LINES; i++)
+    {
+        lines[i] = bench_capture[i % BENCH_CAPTURE_LENGTH];
+    }
+
+    /* Both converters decode the same lines into the same arrays */
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        double start = bench_now();
+        size_t converted = 0;
+        for (size_t i = 0; i < BENCH_LINES; i++)
+        {
+            converted += bench_convert_strtol(lines[i], data[i], errors[i]);
+        }
+        bench_report("strtol (former)", BENCH_LINES, bench_now() - start);
+
+        if (converted != BENCH_LINES)
+        {
+            fprintf(stderr, "Conversion failed: %zu of %d\n", converted, BENCH_LINES);
+            return -1;
+        }
+
+        start = bench_now();
+        converted = rdsparser_convert_strings(lines, BENCH_LINES, data, errors);
+        bench_report("rdsparser_convert_strings", BENCH_LINES, bench_now() - start);
+
+        if (converted != BENCH_LINES)
+        {
+            fprintf(stderr, "Conversion failed: %zu of %d\n", converted, BENCH_LINES);
+            return -1;
+        }
+    }
+
+    free(lines);
+    free(data);
+    free(errors);
+    return 0;
+}
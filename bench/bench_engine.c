@@ -0,0 +1,101 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <librdsparser.h>
+#include "bench.h"
+
+#define BENCH_CHANNELS 200
+#define BENCH_GROUPS 1000000
+#define BENCH_BATCH 4096
+#define BENCH_QUEUE 8192
+
+static void
+callback_ps(rdsparser_t *rds,
+            void        *user_data)
+{
+    (*(size_t*)user_data)++;
+}
+
+int
+main(void)
+{
+    static const uint32_t threads[] = { 1, 2, 4, 8, 16 };
+    rdsparser_data_t *data = malloc(sizeof(rdsparser_data_t) * BENCH_GROUPS);
+    rdsparser_error_t *errors = malloc(sizeof(rdsparser_error_t) * BENCH_GROUPS);
+    uint32_t *channels = malloc(sizeof(uint32_t) * BENCH_GROUPS);
+    size_t *updates = calloc(BENCH_CHANNELS, sizeof(size_t));
+    if (data == NULL || errors == NULL || channels == NULL || updates == NULL)
+    {
+        return -1;
+    }
+
+    /* Consecutive groups of the capture are spread over all channels */
+    bench_load(data, errors, BENCH_GROUPS);
+    for (size_t i = 0; i < BENCH_GROUPS; i++)
+    {
+        channels[i] = (uint32_t)((i / BENCH_CAPTURE_LENGTH) % BENCH_CHANNELS);
+    }
+
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+    {
+        rdsparser_engine_t *engine = rdsparser_engine_new(BENCH_CHANNELS, threads[t], BENCH_QUEUE);
+        if (engine == NULL)
+        {
+            return -1;
+        }
+
+        for (uint32_t channel = 0; channel < BENCH_CHANNELS; channel++)
+        {
+            rdsparser_t *rds = rdsparser_engine_get_channel(engine, channel);
+            updates[channel] = 0;
+            rdsparser_set_user_data(rds, &updates[channel]);
+            rdsparser_register_ps(rds, callback_ps);
+        }
+
+        rdsparser_engine_start(engine, true);
+
+        const double start = bench_now();
+        for (size_t i = 0; i < BENCH_GROUPS; i += BENCH_BATCH)
+        {
+            const size_t count = (BENCH_GROUPS - i < BENCH_BATCH) ? BENCH_GROUPS - i : BENCH_BATCH;
+            rdsparser_engine_push_batch(engine, channels + i,
+                                        (const rdsparser_data_t*)data + i,
+                                        (const rdsparser_error_t*)errors + i,
+                                        count);
+        }
+        rdsparser_engine_flush(engine);
+        const double elapsed = bench_now() - start;
+
+        size_t total = 0;
+        for (uint32_t channel = 0; channel < BENCH_CHANNELS; channel++)
+        {
+            total += updates[channel];
+        }
+
+        printf("%2u threads %10d groups %9.3f ms %12.0f groups/s %8zu PS updates\n",
+               threads[t], BENCH_GROUPS, elapsed * 1e3, (double)BENCH_GROUPS / elapsed, total);
+        rdsparser_engine_free(engine);
+    }
+
+    free(data);
+    free(errors);
+    free(channels);
+    free(updates);
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <librdsparser.h>
+#include "bench.h"
+
+#define BENCH_GROUPS 1000000
+#define BENCH_ROUNDS 5
+
+/* Archival workers: only PI, PS and RT are needed */
+#define BENCH_FEATURES (RDSPARSER_FEATURE_PI | RDSPARSER_FEATURE_PS | RDSPARSER_FEATURE_RT)
+
+static void
+callback_ps(rdsparser_t *rds,
+            void        *user_data)
+{
+    (*(size_t*)user_data)++;
+}
+
+static void
+callback_rt(rdsparser_t         *rds,
+            rdsparser_rt_flag_t  flag,
+            void                *user_data)
+{
+    (*(size_t*)user_data)++;
+}
+
+static double
+bench_run(const rdsparser_data_t  *data,
+          const rdsparser_error_t *errors,
+          rdsparser_feature_t      mask,
+          size_t                  *updates)
+{
+#ifdef RDSPARSER_DISABLE_HEAP
+    static rdsparser_t buffer;
+    rdsparser_t *rds = &buffer;
+#else
+    rdsparser_t *rds = rdsparser_new();
+#endif
+    rdsparser_init(rds);
+    rdsparser_set_feature_mask(rds, mask);
+    rdsparser_set_user_data(rds, updates);
+    rdsparser_register_ps(rds, callback_ps);
+    rdsparser_register_rt(rds, callback_rt);
+
+    const double start = bench_now();
+    for (size_t i = 0; i < BENCH_GROUPS; i++)
+    {
+        rdsparser_parse(rds, data[i], errors[i]);
+    }
+    const double elapsed = bench_now() - start;
+
+#ifndef RDSPARSER_DISABLE_HEAP
+    rdsparser_free(rds);
+#endif
+    return elapsed;
+}
+
+int
+main(void)
+{
+    rdsparser_data_t *data = malloc(sizeof(rdsparser_data_t) * BENCH_GROUPS);
+    rdsparser_error_t *errors = malloc(sizeof(rdsparser_error_t) * BENCH_GROUPS);
+    if (data == NULL || errors == NULL)
+    {
+        return -1;
+    }
+
+    bench_load(data, errors, BENCH_GROUPS);
+
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        size_t all_updates = 0;
+        bench_report("RDSPARSER_FEATURE_ALL", BENCH_GROUPS,
+                     bench_run((const rdsparser_data_t*)data, (const rdsparser_error_t*)errors, RDSPARSER_FEATURE_ALL, &all_updates));
+
+        size_t masked_updates = 0;
+        bench_report("PI | PS | RT", BENCH_GROUPS,
+                     bench_run((const rdsparser_data_t*)data, (const rdsparser_error_t*)errors, BENCH_FEATURES, &masked_updates));
+
+        /* The enabled features must be decoded identically */
+        if (all_updates != masked_updates)
+        {
+            fprintf(stderr, "Result mismatch: %zu != %zu\n", all_updates, masked_updates);
+            return -1;
+        }
+    }
+
+    free(data);
+    free(errors);
+    return 0;
+}
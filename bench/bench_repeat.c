@@ -0,0 +1,146 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <librdsparser.h>
+#include "bench.h"
+
+#define BENCH_GROUPS 1000000
+#define BENCH_ROUNDS 5
+
+/* Converged station: PS, AF pairs and a 64-character RT in a loop */
+static const char *bench_loop[] =
+{
+    "3201054022415432",
+    "3201054122415220",
+    "3201054222415241",
+    "3201054322414449",
+    "320125404D757369",
+    "3201254163207365",
+    "3201254272766963",
+    "3201254365206F6E",
+    "3201254420746865",
+    "32012545206C6F6F",
+    "3201254670202020",
+    "3201254720202020",
+    "3201254820202020",
+    "3201254920202020",
+    "3201254A20202020",
+    "3201254B20202020",
+    "3201254C20202020",
+    "3201254D20202020",
+    "3201254E20202020",
+    "3201254F20202020"
+};
+
+#define BENCH_LOOP_LENGTH (sizeof(bench_loop) / sizeof(bench_loop[0]))
+
+static double
+bench_run(const rdsparser_data_t  *data,
+          const rdsparser_error_t *errors,
+          bool                     flush,
+          double                  *hit_rate)
+{
+#ifdef RDSPARSER_DISABLE_HEAP
+    static rdsparser_t buffer;
+    rdsparser_t *rds = &buffer;
+#else
+    rdsparser_t *rds = rdsparser_new();
+#endif
+    rdsparser_init(rds);
+
+    const double start = bench_now();
+    for (size_t i = 0; i < BENCH_GROUPS; i++)
+    {
+        if (flush)
+        {
+            /* Any change of the settings invalidates the cache */
+            rdsparser_set_text_progressive(rds, RDSPARSER_TEXT_PS, false);
+        }
+        rdsparser_parse(rds, data[i], errors[i]);
+    }
+    const double elapsed = bench_now() - start;
+
+    *hit_rate = (double)rdsparser_get_repeat_hits(rds) / (double)rdsparser_get_repeat_lookups(rds);
+#ifndef RDSPARSER_DISABLE_HEAP
+    rdsparser_free(rds);
+#endif
+    return elapsed;
+}
+
+static double
+bench_flush(void)
+{
+#ifdef RDSPARSER_DISABLE_HEAP
+    static rdsparser_t buffer;
+    rdsparser_t *rds = &buffer;
+#else
+    rdsparser_t *rds = rdsparser_new();
+#endif
+    rdsparser_init(rds);
+
+    /* Cost of the flush alone, included in the flushed runs */
+    const double start = bench_now();
+    for (size_t i = 0; i < BENCH_GROUPS; i++)
+    {
+        rdsparser_set_text_progressive(rds, RDSPARSER_TEXT_PS, false);
+    }
+    const double elapsed = bench_now() - start;
+
+#ifndef RDSPARSER_DISABLE_HEAP
+    rdsparser_free(rds);
+#endif
+    return elapsed;
+}
+
+int
+main(void)
+{
+    rdsparser_data_t *data = malloc(sizeof(rdsparser_data_t) * BENCH_GROUPS);
+    rdsparser_error_t *errors = malloc(sizeof(rdsparser_error_t) * BENCH_GROUPS);
+    if (data == NULL || errors == NULL)
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < BENCH_GROUPS; i++)
+    {
+        bench_decode(bench_loop[i % BENCH_LOOP_LENGTH], data[i], errors[i]);
+    }
+
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        double hit_rate;
+        bench_report("loop", BENCH_GROUPS,
+                     bench_run((const rdsparser_data_t*)data, (const rdsparser_error_t*)errors, false, &hit_rate));
+        printf("%-24s %9.1f %%\n", "hit rate", hit_rate * 100.0);
+        bench_report("loop (flushed)", BENCH_GROUPS,
+                     bench_run((const rdsparser_data_t*)data, (const rdsparser_error_t*)errors, true, &hit_rate));
+        bench_report("flush only", BENCH_GROUPS, bench_flush());
+    }
+
+    /* Real-world capture with errors */
+    bench_load(data, errors, BENCH_GROUPS);
+    double hit_rate;
+    bench_report("capture", BENCH_GROUPS,
+                 bench_run((const rdsparser_data_t*)data, (const rdsparser_error_t*)errors, false, &hit_rate));
+    printf("%-24s %9.1f %%\n", "hit rate", hit_rate * 100.0);
+
+    free(data);
+    free(errors);
+    return 0;
+}
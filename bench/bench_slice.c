@@ -0,0 +1,101 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <librdsparser.h>
+#include "bench.h"
+
+#define BENCH_GROUPS 20000
+#define BENCH_ROUNDS 5
+
+int
+main(void)
+{
+    const size_t bits = (size_t)BENCH_GROUPS * BENCH_GROUP_BITS;
+    const size_t bytes = (bits + 7) / 8;
+    rdsparser_data_t *data = malloc(sizeof(rdsparser_data_t) * (BENCH_GROUPS + RDSPARSER_SLICE_LANES));
+    rdsparser_error_t *errors = malloc(sizeof(rdsparser_error_t) * (BENCH_GROUPS + RDSPARSER_SLICE_LANES));
+    uint8_t *streams = calloc(bytes, RDSPARSER_SLICE_LANES);
+    rdsparser_t **rds = malloc(sizeof(rdsparser_t*) * RDSPARSER_SLICE_LANES);
+    rdsparser_sync_t **sync = malloc(sizeof(rdsparser_sync_t*) * RDSPARSER_SLICE_LANES);
+    const uint8_t *buffers[RDSPARSER_SLICE_LANES];
+    if (data == NULL || errors == NULL || streams == NULL || rds == NULL || sync == NULL)
+    {
+        return -1;
+    }
+
+    bench_load(data, errors, BENCH_GROUPS + RDSPARSER_SLICE_LANES);
+
+    /* Each lane starts at a different group of the capture */
+    for (int lane = 0; lane < RDSPARSER_SLICE_LANES; lane++)
+    {
+        bench_bitstream(streams + lane * bytes, (const rdsparser_data_t*)data + lane, BENCH_GROUPS);
+        buffers[lane] = streams + lane * bytes;
+        rds[lane] = rdsparser_new();
+        sync[lane] = rdsparser_sync_new(rds[lane]);
+    }
+
+    rdsparser_slice_t *slice = rdsparser_slice_new();
+
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        size_t scalar_groups = 0;
+        double start = bench_now();
+        for (int lane = 0; lane < RDSPARSER_SLICE_LANES; lane++)
+        {
+            rdsparser_sync_reset(sync[lane]);
+            scalar_groups += rdsparser_sync_feed(sync[lane], buffers[lane], bits);
+        }
+        double elapsed = bench_now() - start;
+        printf("%-28s %2d lanes %9.3f ms %10.2f Mbit/s\n", "rdsparser_sync_feed",
+               RDSPARSER_SLICE_LANES, elapsed * 1e3, (double)bits * RDSPARSER_SLICE_LANES / elapsed / 1e6);
+
+        rdsparser_slice_init(slice);
+        for (int lane = 0; lane < RDSPARSER_SLICE_LANES; lane++)
+        {
+            rdsparser_init(rds[lane]);
+            rdsparser_slice_attach(slice, (uint8_t)lane, rds[lane]);
+        }
+
+        start = bench_now();
+        const size_t slice_groups = rdsparser_slice_feed_lanes(slice, buffers, bits);
+        elapsed = bench_now() - start;
+        printf("%-28s %2d lanes %9.3f ms %10.2f Mbit/s\n", "rdsparser_slice_feed_lanes",
+               RDSPARSER_SLICE_LANES, elapsed * 1e3, (double)bits * RDSPARSER_SLICE_LANES / elapsed / 1e6);
+
+        if (scalar_groups != slice_groups)
+        {
+            fprintf(stderr, "Result mismatch: %zu != %zu\n", scalar_groups, slice_groups);
+            return -1;
+        }
+    }
+
+    for (int lane = 0; lane < RDSPARSER_SLICE_LANES; lane++)
+    {
+        rdsparser_sync_free(sync[lane]);
+        rdsparser_free(rds[lane]);
+    }
+
+    rdsparser_slice_free(slice);
+    free(sync);
+    free(rds);
+    free(streams);
+    free(data);
+    free(errors);
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <librdsparser.h>
+#include "bench.h"
+
+#define BENCH_GROUPS 200000
+#define BENCH_ROUNDS 5
+/* Approximately one bit error per 1000 bits */
+#define BENCH_ERROR_RATE 1000
+
+int
+main(void)
+{
+    const size_t bits = (size_t)BENCH_GROUPS * BENCH_GROUP_BITS;
+    rdsparser_data_t *data = malloc(sizeof(rdsparser_data_t) * BENCH_GROUPS);
+    rdsparser_error_t *errors = malloc(sizeof(rdsparser_error_t) * BENCH_GROUPS);
+    uint8_t *clean = calloc((bits + 7) / 8, 1);
+    uint8_t *noisy = malloc((bits + 7) / 8);
+    if (data == NULL || errors == NULL || clean == NULL || noisy == NULL)
+    {
+        return -1;
+    }
+
+    bench_load(data, errors, BENCH_GROUPS);
+
+    bench_bitstream(clean, (const rdsparser_data_t*)data, BENCH_GROUPS);
+
+    uint32_t seed = 1;
+    for (size_t i = 0; i < (bits + 7) / 8; i++)
+    {
+        noisy[i] = clean[i];
+    }
+    for (size_t i = 0; i < bits / BENCH_ERROR_RATE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        const size_t position = (size_t)(((uint64_t)seed * bits) >> 32);
+        noisy[position / 8] ^= (uint8_t)(0x80 >> (position % 8));
+    }
+
+    const struct
+    {
+        const char *name;
+        const uint8_t *buffer;
+    } inputs[] =
+    {
+        { "rdsparser_sync_feed", clean },
+        { "rdsparser_sync_feed (BER 1e-3)", noisy }
+    };
+
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (size_t input = 0; input < sizeof(inputs) / sizeof(inputs[0]); input++)
+        {
+#ifdef RDSPARSER_DISABLE_HEAP
+            static rdsparser_t rds_buffer;
+            static rdsparser_sync_t sync_buffer;
+            rdsparser_t *rds = &rds_buffer;
+            rdsparser_sync_t *sync = &sync_buffer;
+            rdsparser_init(rds);
+            rdsparser_sync_init(sync, rds);
+#else
+            rdsparser_t *rds = rdsparser_new();
+            rdsparser_sync_t *sync = rdsparser_sync_new(rds);
+#endif
+
+            const double start = bench_now();
+            rdsparser_sync_feed(sync, inputs[input].buffer, bits);
+            const double elapsed = bench_now() - start;
+
+            printf("%-32s %10zu bits %9.3f ms %10.2f Mbit/s  groups %u, corrected %u, uncorrectable %u\n",
+                   inputs[input].name, bits, elapsed * 1e3, (double)bits / elapsed / 1e6,
+                   rdsparser_sync_get_groups(sync),
+                   rdsparser_sync_get_corrected(sync),
+                   rdsparser_sync_get_uncorrectable(sync));
+
+#ifndef RDSPARSER_DISABLE_HEAP
+            rdsparser_sync_free(sync);
+            rdsparser_free(rds);
+#endif
+        }
+    }
+
+    free(data);
+    free(errors);
+    free(clean);
+    free(noisy);
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <librdsparser.h>
+#include "bench.h"
+
+#define BENCH_TRIALS 20000
+#define BENCH_LIMIT 200
+#define BENCH_PI 0x3201
+
+/* Corrected blocks are not always corrected properly */
+#define BENCH_WRONG_SMALL 0.05
+#define BENCH_WRONG_LARGE 0.25
+
+typedef enum bench_mode
+{
+    BENCH_MODE_DEFAULT,
+    BENCH_MODE_EXTENDED_CHECK,
+    BENCH_MODE_VOTING,
+    BENCH_MODE_COUNT
+} bench_mode_t;
+
+static const char *bench_mode_name[BENCH_MODE_COUNT] =
+{
+    "default",
+    "extended check",
+    "voting 5/4"
+};
+
+static const double bench_bler[] = { 0.05, 0.1, 0.2, 0.3, 0.4 };
+
+/* Deterministic xorshift, the results are reproducible */
+static uint32_t bench_state = 0x12345678;
+
+static double
+bench_random(void)
+{
+    bench_state ^= bench_state << 13;
+    bench_state ^= bench_state >> 17;
+    bench_state ^= bench_state << 5;
+    return (double)bench_state / 4294967296.0;
+}
+
+static rdsparser_block_error_t
+bench_channel(uint16_t *block,
+              double    bler)
+{
+    const double u = bench_random();
+    if (u < bler)
+    {
+        return RDSPARSER_BLOCK_ERROR_UNCORRECTABLE;
+    }
+
+    if (u < 2 * bler)
+    {
+        const bool small = (u < 1.5 * bler);
+        if (bench_random() < (small ? BENCH_WRONG_SMALL : BENCH_WRONG_LARGE))
+        {
+            *block ^= (uint16_t)(1 + bench_random() * 0xFFFE);
+        }
+        return (small ? RDSPARSER_BLOCK_ERROR_SMALL : RDSPARSER_BLOCK_ERROR_LARGE);
+    }
+
+    return RDSPARSER_BLOCK_ERROR_NONE;
+}
+
+static void
+bench_run(rdsparser_t  *rds,
+          bench_mode_t  mode,
+          double        bler)
+{
+    rdsparser_set_extended_check(rds, (mode == BENCH_MODE_EXTENDED_CHECK));
+    rdsparser_set_voting(rds, RDSPARSER_FEATURE_PI, (mode == BENCH_MODE_VOTING ? 5 : 0), 4);
+
+    size_t total = 0;
+    size_t locked = 0;
+    size_t false_locks = 0;
+
+    for (int trial = 0; trial < BENCH_TRIALS; trial++)
+    {
+        rdsparser_clear(rds);
+        bool false_lock = false;
+
+        for (int i = 1; i <= BENCH_LIMIT; i++)
+        {
+            rdsparser_data_t data = { BENCH_PI, 0x0000, 0xE0CD, 0x2020 };
+            rdsparser_error_t errors;
+            for (int block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+            {
+                errors[block] = bench_channel(&data[block], bler);
+            }
+
+            rdsparser_parse(rds, data, errors);
+
+            const rdsparser_pi_t pi = rdsparser_get_pi(rds);
+            if (pi == BENCH_PI)
+            {
+                total += i;
+                locked++;
+                break;
+            }
+
+            if (pi != RDSPARSER_PI_UNKNOWN)
+            {
+                false_lock = true;
+            }
+        }
+
+        false_locks += false_lock;
+    }
+
+    printf("BLER %.2f %-16s %8.2f groups to lock %6zu unlocked %6zu false locks\n",
+           bler, bench_mode_name[mode],
+           (locked ? (double)total / (double)locked : 0.0),
+           (size_t)BENCH_TRIALS - locked, false_locks);
+}
+
+int
+main(void)
+{
+#ifdef RDSPARSER_DISABLE_HEAP
+    static rdsparser_t buffer;
+    rdsparser_t *rds = &buffer;
+#else
+    rdsparser_t *rds = rdsparser_new();
+    if (rds == NULL)
+    {
+        return -1;
+    }
+#endif
+    rdsparser_init(rds);
+    rdsparser_set_feature_mask(rds, RDSPARSER_FEATURE_PI);
+
+    for (size_t i = 0; i < sizeof(bench_bler) / sizeof(bench_bler[0]); i++)
+    {
+        for (int mode = 0; mode < BENCH_MODE_COUNT; mode++)
+        {
+            bench_run(rds, (bench_mode_t)mode, bench_bler[i]);
+        }
+    }
+
+#ifndef RDSPARSER_DISABLE_HEAP
+    rdsparser_free(rds);
+#endif
+    return 0;
+}
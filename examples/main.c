@@ -272,13 +272,17 @@ callback_ps(rdsparser_t *rds,
             void        *user_data)
 {
     const rdsparser_string_t *ps = rdsparser_get_ps(rds);
-    const rdsparser_string_char_t *ps_content = rdsparser_string_get_content(ps);
     const uint8_t *ps_errors = rdsparser_string_get_errors(ps);
     const uint8_t length = rdsparser_string_get_length(ps);
 #ifdef RDSPARSER_DISABLE_UNICODE
-    printf("PS: %s", ps_content);
+    printf("PS: %s", rdsparser_string_get_content(ps));
+#elif defined(RDSPARSER_COMPACT_STRINGS)
+    /* Raw RDS codes, converted on request */
+    char ps_text[3 * RDSPARSER_PS_LENGTH + 1];
+    rdsparser_string_to_utf8(ps, ps_text, sizeof(ps_text));
+    printf("PS: %s", ps_text);
 #else
-    printf("PS: %ls", ps_content);
+    printf("PS: %ls", rdsparser_string_get_content(ps));
 #endif
     printf(" (");
     for (uint8_t i = 0; i < length; i++)
@@ -296,11 +300,14 @@ callback_rt(rdsparser_t         *rds,
             void                *user_data)
 {
     const rdsparser_string_t *rt = rdsparser_get_rt(rds, flag);
-    const rdsparser_string_char_t *rt_content = rdsparser_string_get_content(rt);
 #ifdef RDSPARSER_DISABLE_UNICODE
-    printf("RT%d: %s\n", flag, rt_content);
+    printf("RT%d: %s\n", flag, rdsparser_string_get_content(rt));
+#elif defined(RDSPARSER_COMPACT_STRINGS)
+    char rt_text[3 * RDSPARSER_RT_LENGTH + 1];
+    rdsparser_string_to_utf8(rt, rt_text, sizeof(rt_text));
+    printf("RT%d: %s\n", flag, rt_text);
 #else
-    printf("RT%d: %ls\n", flag, rt_content);
+    printf("RT%d: %ls\n", flag, rdsparser_string_get_content(rt));
 #endif
 }
 
@@ -309,11 +316,14 @@ callback_ptyn(rdsparser_t *rds,
               void        *user_data)
 {
     const rdsparser_string_t *ptyn = rdsparser_get_ptyn(rds);
-    const rdsparser_string_char_t *ptyn_content = rdsparser_string_get_content(ptyn);
 #ifdef RDSPARSER_DISABLE_UNICODE
-    printf("PTYN: %s\n", ptyn_content);
+    printf("PTYN: %s\n", rdsparser_string_get_content(ptyn));
+#elif defined(RDSPARSER_COMPACT_STRINGS)
+    char ptyn_text[3 * RDSPARSER_PTYN_LENGTH + 1];
+    rdsparser_string_to_utf8(ptyn, ptyn_text, sizeof(ptyn_text));
+    printf("PTYN: %s\n", ptyn_text);
 #else
-    printf("PTYN: %ls\n", ptyn_content);
+    printf("PTYN: %ls\n", rdsparser_string_get_content(ptyn));
 #endif
 }
 
@@ -322,6 +332,13 @@ callback_ct(rdsparser_t          *rds,
             const rdsparser_ct_t *ct,
             void                 *user_data)
 {
+    if (ct == NULL)
+    {
+        /* Cleared by a station change */
+        printf("CT: -\n");
+        return;
+    }
+
     int16_t offset = rdsparser_ct_get_offset(ct);
 
     printf("CT: %04d-%02d-%02d %02d:%02d (%c%02d:%02d)\n",
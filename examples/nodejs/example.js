@@ -6,18 +6,39 @@ const unicode_type = (win32 ? 'int16_t' : 'int32_t')
 const filename = 'librdsparser.' + (win32 ? 'dll' : 'so')
 const lib = koffi.load(path.join(__dirname, filename));
 
-koffi.proto('void callback_pi(void *rds, void *user_data)');
-koffi.proto('void callback_pty(void *rds, void *user_data)');
-koffi.proto('void callback_tp(void *rds, void *user_data)');
-koffi.proto('void callback_ta(void *rds, void *user_data)');
-koffi.proto('void callback_ms(void *rds, void *user_data)');
-koffi.proto('void callback_ecc(void *rds, void *user_data)');
-koffi.proto('void callback_country(void *rds, void *user_data)');
-koffi.proto('void callback_af(void *rds, uint32_t af, void *user_data)');
-koffi.proto('void callback_ps(void *rds, void *user_data)');
-koffi.proto('void callback_rt(void *rds, int flag, void *user_data)');
-koffi.proto('void callback_ptyn(void *rds, void *user_data)');
-koffi.proto('void callback_ct(void *rds, void *ct, void *user_data)');
+const rdsparser_event_payload = koffi.struct('rdsparser_event_payload', {
+    type: 'uint8_t',
+    flag: 'uint8_t',
+    length: 'uint8_t',
+    reserved: 'uint8_t',
+    value: 'int32_t',
+    content: 'void*',
+    errors: 'void*',
+    year: 'uint16_t',
+    month: 'uint8_t',
+    day: 'uint8_t',
+    hour: 'uint8_t',
+    minute: 'uint8_t',
+    offset: 'int16_t',
+    changed: 'uint64_t'
+});
+
+koffi.proto('void callback_event(void *rds, uint8_t type, void *payload, void *user_data)');
+
+const RDSPARSER_EVENT = {
+    PI: 0,
+    PTY: 1,
+    TP: 2,
+    TA: 3,
+    MS: 4,
+    ECC: 5,
+    COUNTRY: 6,
+    AF: 7,
+    PS: 8,
+    RT: 9,
+    PTYN: 10,
+    CT: 11
+};
 
 const rdsparser = {
     new: lib.func('void* rdsparser_new()'),
@@ -27,141 +48,95 @@ const rdsparser = {
     set_extended_check: lib.func('bool rdsparser_set_extended_check(void *rds, bool value)'),
     set_text_correction: lib.func('bool rdsparser_set_text_correction(void *rds, uint8_t text, uint8_t type, uint8_t error)'),
     set_text_progressive: lib.func('bool rdsparser_set_text_progressive(void *rds, uint8_t string, bool state)'),
-    get_pi: lib.func('int32_t rdsparser_get_pi(void *rds)'),
-    get_pty: lib.func('int8_t rdsparser_get_pty(void *rds)'),
-    get_tp: lib.func('int8_t rdsparser_get_tp(void *rds)'),
-    get_ta: lib.func('int8_t rdsparser_get_ta(void *rds)'),
-    get_ms: lib.func('int8_t rdsparser_get_ms(void *rds)'),
-    get_ecc: lib.func('int16_t rdsparser_get_ecc(void *rds)'),
-    get_country: lib.func('int rdsparser_get_country(void *rds)'),
-    get_ps: lib.func('void* rdsparser_get_ps(void *rds)'),
-    get_rt: lib.func('void* rdsparser_get_rt(void *rds, int flag)'),
-    get_ptyn: lib.func('void* rdsparser_get_ptyn(void *rds)'),
-    register_pi: lib.func('void rdsparser_register_pi(void *rds, void *cb)'),
-    register_pty: lib.func('void rdsparser_register_pty(void *rds, void *cb)'),
-    register_tp: lib.func('void rdsparser_register_tp(void *rds, void *cb)'),
-    register_ta: lib.func('void rdsparser_register_ta(void *rds, void *cb)'),
-    register_ms: lib.func('void rdsparser_register_ms(void *rds, void *cb)'),
-    register_ecc: lib.func('void rdsparser_register_ecc(void *rds, void *cb)'),
-    register_country: lib.func('void rdsparser_register_country(void *rds, void *cb)'),
-    register_af: lib.func('void rdsparser_register_af(void *rds, void *cb)'),
-    register_ps: lib.func('void rdsparser_register_ps(void *rds, void *cb)'),
-    register_rt: lib.func('void rdsparser_register_rt(void *rds, void *cb)'),
-    register_ptyn: lib.func('void rdsparser_register_ptyn(void *rds, void *cb)'),
-    register_ct: lib.func('void rdsparser_register_ct(void *rds, void *cb)'),
-    string_get_content: lib.func(unicode_type + '* rdsparser_string_get_content(void *string)'),
-    string_get_errors: lib.func('uint8_t* rdsparser_string_get_errors(void *string)'),
-    string_get_length: lib.func('uint8_t rdsparser_string_get_length(void *string)'),
-    ct_get_year: lib.func('uint16_t rdsparser_ct_get_year(void *ct)'),
-    ct_get_month: lib.func('uint8_t rdsparser_ct_get_month(void *ct)'),
-    ct_get_day: lib.func('uint8_t rdsparser_ct_get_day(void *ct)'),
-    ct_get_hour: lib.func('uint8_t rdsparser_ct_get_hour(void *ct)'),
-    ct_get_minute: lib.func('uint8_t rdsparser_ct_get_minute(void *ct)'),
-    ct_get_offset: lib.func('int8_t rdsparser_ct_get_offset(void *ct)'),
+    register_event: lib.func('void rdsparser_register_event(void *rds, void *cb)'),
     pty_lookup_short: lib.func('const char* rdsparser_pty_lookup_short(int8_t pty, bool rbds)'),
     pty_lookup_long: lib.func('const char* rdsparser_pty_lookup_long(int8_t pty, bool rbds)'),
     country_lookup_name: lib.func('const char* rdsparser_country_lookup_name(int country)'),
     country_lookup_iso: lib.func('const char* rdsparser_country_lookup_iso(int country)')
 }
 
-const decode_unicode = function(string) {
-    let content = rdsparser.string_get_content(string);
-    let length = rdsparser.string_get_length(string);
-    if (length) {
-        let array = koffi.decode(content, unicode_type + ' [' + length + ']');
+/* The payload already carries the string, no getters are needed */
+const decode_unicode = function(payload) {
+    if (payload.length) {
+        let array = koffi.decode(payload.content, unicode_type + ' [' + payload.length + ']');
         return String.fromCodePoint.apply(String, array);
     }
     return '';
 };
 
-const decode_errors = function(string) {
-    let errors = rdsparser.string_get_errors(string);
-    let length = rdsparser.string_get_length(string);
-    if (length) {
-        let array = koffi.decode(errors, 'uint8_t [' + length + ']');
+const decode_errors = function(payload) {
+    if (payload.length) {
+        let array = koffi.decode(payload.errors, 'uint8_t [' + payload.length + ']');
         return Uint8Array.from(array).toString();
     }
     return '';
 };
 
-const callbacks = {
-    pi: koffi.register(rds => (
-        value = rdsparser.get_pi(rds),
-        console.log('PI: ' + value.toString(16).toUpperCase())
-    ), 'callback_pi*'),
+const handlers = {
+    [RDSPARSER_EVENT.PI]: payload => (
+        console.log('PI: ' + payload.value.toString(16).toUpperCase())
+    ),
 
-    pty: koffi.register(rds => (
-        value = rdsparser.get_pty(rds),
-        display = rdsparser.pty_lookup_long(value, false),
-        console.log('PTY: ' + display + ' (' + value + ')')
-    ), 'callback_pty*'),
+    [RDSPARSER_EVENT.PTY]: payload => (
+        display = rdsparser.pty_lookup_long(payload.value, false),
+        console.log('PTY: ' + display + ' (' + payload.value + ')')
+    ),
 
-    tp: koffi.register(rds => (
-        value = rdsparser.get_tp(rds),
-        console.log('TP: ' + value)
-    ), 'callback_tp*'),
+    [RDSPARSER_EVENT.TP]: payload => (
+        console.log('TP: ' + payload.value)
+    ),
 
-    ta: koffi.register(rds => (
-        value = rdsparser.get_ta(rds),
-        console.log('TA: ' + value)
-    ), 'callback_ta*'),
+    [RDSPARSER_EVENT.TA]: payload => (
+        console.log('TA: ' + payload.value)
+    ),
 
-    ms: koffi.register(rds => (
-        value = rdsparser.get_ms(rds),
-        console.log('MS: ' + value)
-    ), 'callback_ms*'),
+    [RDSPARSER_EVENT.MS]: payload => (
+        console.log('MS: ' + payload.value)
+    ),
 
-    af: koffi.register((rds, value) => (
-        console.log('AF: ' + value)
-    ), 'callback_af*'),
+    [RDSPARSER_EVENT.AF]: payload => (
+        console.log('AF: ' + payload.value)
+    ),
 
-    ecc: koffi.register(rds => (
-        value = rdsparser.get_ecc(rds),
-        console.log('ECC: ' + value.toString(16).toUpperCase())
-    ), 'callback_ecc*'),
+    [RDSPARSER_EVENT.ECC]: payload => (
+        console.log('ECC: ' + payload.value.toString(16).toUpperCase())
+    ),
 
-    country: koffi.register(rds => (
-        value = rdsparser.get_country(rds),
-        display = rdsparser.country_lookup_name(value),
-        iso = rdsparser.country_lookup_iso(value),
+    [RDSPARSER_EVENT.COUNTRY]: payload => (
+        display = rdsparser.country_lookup_name(payload.value),
+        iso = rdsparser.country_lookup_iso(payload.value),
         console.log('Country: ' + display + ' (' + iso + ')')
-    ), 'callback_country*'),
+    ),
 
-    ps: koffi.register(rds => (
-        ps = rdsparser.get_ps(rds),
-        value = decode_unicode(ps),
-        errors = decode_errors(ps),
-        console.log('PS: ' + value +  '(' + errors + ')')
-    ), 'callback_ps*'),
+    [RDSPARSER_EVENT.PS]: payload => (
+        console.log('PS: ' + decode_unicode(payload) + '(' + decode_errors(payload) + ')')
+    ),
 
-    rt: koffi.register((rds, flag) => (
-        rt = rdsparser.get_rt(rds, flag),
-        value = decode_unicode(rt),
-        errors = decode_errors(rt),
-        console.log('RT' + flag  + ': ' + value + ' (' + errors + ')')
-    ), 'callback_rt*'),
+    [RDSPARSER_EVENT.RT]: payload => (
+        console.log('RT' + payload.flag + ': ' + decode_unicode(payload) + ' (' + decode_errors(payload) + ')')
+    ),
 
-    ptyn: koffi.register((rds, flag) => (
-        ptyn = rdsparser.get_ptyn(rds),
-        value = decode_unicode(ptyn),
-        errors = decode_errors(ptyn),
-        console.log('PTYN: ' + value + ' (' + errors + ')')
-    ), 'callback_ptyn*'),
+    [RDSPARSER_EVENT.PTYN]: payload => (
+        console.log('PTYN: ' + decode_unicode(payload) + ' (' + decode_errors(payload) + ')')
+    ),
 
-    ct: koffi.register((rds, ct) => (
-        year = rdsparser.ct_get_year(ct),
-        month = String(rdsparser.ct_get_month(ct)).padStart(2, '0'),
-        day = String(rdsparser.ct_get_day(ct)).padStart(2, '0'),
-        hour = String(rdsparser.ct_get_hour(ct)).padStart(2, '0'),
-        minute = String(rdsparser.ct_get_minute(ct)).padStart(2, '0'),
-        offset = rdsparser.ct_get_offset(ct),
-        tz_sign = (offset >= 0 ? '+' : '-'),
-        tz_hour = String(Math.abs(Math.floor(offset / 60))).padStart(2, '0'),
-        tz_minute = String(Math.abs(offset % 60)).padStart(2, '0'),
-        console.log('CT: ' + year + '-' + month + '-' + day + ' ' + hour + ':' + minute + ' (' + tz_sign + tz_hour + ':' + tz_minute + ')')
-    ), 'callback_ct*')
+    [RDSPARSER_EVENT.CT]: payload => (
+        month = String(payload.month).padStart(2, '0'),
+        day = String(payload.day).padStart(2, '0'),
+        hour = String(payload.hour).padStart(2, '0'),
+        minute = String(payload.minute).padStart(2, '0'),
+        tz_sign = (payload.offset >= 0 ? '+' : '-'),
+        tz_hour = String(Math.abs(Math.floor(payload.offset / 60))).padStart(2, '0'),
+        tz_minute = String(Math.abs(payload.offset % 60)).padStart(2, '0'),
+        console.log('CT: ' + payload.year + '-' + month + '-' + day + ' ' + hour + ':' + minute + ' (' + tz_sign + tz_hour + ':' + tz_minute + ')')
+    )
 }
 
+/* A single trampoline for all the events */
+const callback = koffi.register((rds, type, payload) => (
+    handlers[type](koffi.decode(payload, rdsparser_event_payload))
+), 'callback_event*');
+
 let rds = rdsparser.new()
 rdsparser.set_text_correction(rds, 0, 0, 2);
 rdsparser.set_text_correction(rds, 0, 1, 2);
@@ -169,18 +144,7 @@ rdsparser.set_text_correction(rds, 1, 0, 2);
 rdsparser.set_text_correction(rds, 1, 1, 2);
 rdsparser.set_text_progressive(rds, 0, true);
 rdsparser.set_text_progressive(rds, 1, true);
-rdsparser.register_pi(rds, callbacks.pi);
-rdsparser.register_pty(rds, callbacks.pty);
-rdsparser.register_tp(rds, callbacks.tp);
-rdsparser.register_ta(rds, callbacks.ta);
-rdsparser.register_ms(rds, callbacks.ms);
-rdsparser.register_ecc(rds, callbacks.ecc);
-rdsparser.register_country(rds, callbacks.country);
-rdsparser.register_af(rds, callbacks.af);
-rdsparser.register_ps(rds, callbacks.ps);
-rdsparser.register_rt(rds, callbacks.rt);
-rdsparser.register_ptyn(rds, callbacks.ptyn);
-rdsparser.register_ct(rds, callbacks.ct);
+rdsparser.register_event(rds, callback);
 
 let data = [
     "A20120017420696E02",
@@ -372,8 +336,6 @@ for (let group of data) {
     rdsparser.parse_string(rds, group);
 }
 
-for (let cb in callbacks) {
-    koffi.unregister(callbacks[cb]);
-}
+koffi.unregister(callback);
 
 rdsparser.free(rds);
@@ -17,6 +17,7 @@
 #ifndef RDSPARSER_H
 #define RDSPARSER_H
 #include <stdint.h>
+#include <stddef.h>
 #include <stdbool.h>
 
 #ifdef __cplusplus
@@ -28,6 +29,15 @@ extern "C" {
 #define RDSPARSER_RT_LENGTH 64
 #define RDSPARSER_PTYN_LENGTH 8
 
+#define RDSPARSER_SLICE_LANES 64
+
+#define RDSPARSER_VOTING_WINDOW_MAX 8
+
+#define RDSPARSER_CAPTURE_HEADER_SIZE 8
+#define RDSPARSER_CAPTURE_RECORD_SIZE 9
+#define RDSPARSER_CAPTURE_DELTA_SIZE 2
+#define RDSPARSER_CAPTURE_FLAG_DELTA 0x01
+
 typedef uint8_t rdsparser_block_t;
 enum rdsparser_block
 {
@@ -80,6 +90,15 @@ enum rdsparser_string_error
     RDSPARSER_STRING_ERROR_UNCORRECTABLE
 };
 
+typedef uint8_t rdsparser_string_table_t;
+enum rdsparser_string_table
+{
+    RDSPARSER_STRING_TABLE_G0 = 0,
+    RDSPARSER_STRING_TABLE_G1 = 1,
+    RDSPARSER_STRING_TABLE_G2 = 2,
+    RDSPARSER_STRING_TABLE_COUNT
+};
+
 typedef uint8_t rdsparser_rt_flag_t;
 enum rdsparser_rt_flag
 {
@@ -88,6 +107,79 @@ enum rdsparser_rt_flag
     RDSPARSER_RT_FLAG_COUNT
 };
 
+typedef uint16_t rdsparser_feature_t;
+enum rdsparser_feature
+{
+    RDSPARSER_FEATURE_PI = (1 << 0),
+    RDSPARSER_FEATURE_PTY = (1 << 1),
+    RDSPARSER_FEATURE_TP = (1 << 2),
+    RDSPARSER_FEATURE_TA = (1 << 3),
+    RDSPARSER_FEATURE_MS = (1 << 4),
+    RDSPARSER_FEATURE_ECC = (1 << 5),
+    RDSPARSER_FEATURE_AF = (1 << 6),
+    RDSPARSER_FEATURE_PS = (1 << 7),
+    RDSPARSER_FEATURE_RT = (1 << 8),
+    RDSPARSER_FEATURE_PTYN = (1 << 9),
+    RDSPARSER_FEATURE_CT = (1 << 10),
+    RDSPARSER_FEATURE_ALL = (1 << 11) - 1
+};
+
+/* Fields supporting the voting confirmation */
+#define RDSPARSER_VOTING_FEATURES (RDSPARSER_FEATURE_PI | RDSPARSER_FEATURE_PTY | RDSPARSER_FEATURE_TP | \
+                                   RDSPARSER_FEATURE_TA | RDSPARSER_FEATURE_MS | RDSPARSER_FEATURE_ECC)
+
+typedef uint16_t rdsparser_change_t;
+enum rdsparser_change
+{
+    RDSPARSER_CHANGE_PI = (1 << 0),
+    RDSPARSER_CHANGE_PTY = (1 << 1),
+    RDSPARSER_CHANGE_TP = (1 << 2),
+    RDSPARSER_CHANGE_TA = (1 << 3),
+    RDSPARSER_CHANGE_MS = (1 << 4),
+    RDSPARSER_CHANGE_ECC = (1 << 5),
+    RDSPARSER_CHANGE_COUNTRY = (1 << 6),
+    RDSPARSER_CHANGE_AF = (1 << 7),
+    RDSPARSER_CHANGE_PS = (1 << 8),
+    RDSPARSER_CHANGE_RT_A = (1 << 9),
+    RDSPARSER_CHANGE_RT_B = (1 << 10),
+    RDSPARSER_CHANGE_PTYN = (1 << 11),
+    RDSPARSER_CHANGE_CT = (1 << 12),
+    RDSPARSER_CHANGE_ALL = (1 << 13) - 1
+};
+
+typedef uint8_t rdsparser_event_type_t;
+enum rdsparser_event_type
+{
+    RDSPARSER_EVENT_PI = 0,
+    RDSPARSER_EVENT_PTY = 1,
+    RDSPARSER_EVENT_TP = 2,
+    RDSPARSER_EVENT_TA = 3,
+    RDSPARSER_EVENT_MS = 4,
+    RDSPARSER_EVENT_ECC = 5,
+    RDSPARSER_EVENT_COUNTRY = 6,
+    RDSPARSER_EVENT_AF = 7,
+    RDSPARSER_EVENT_PS = 8,
+    RDSPARSER_EVENT_RT = 9,
+    RDSPARSER_EVENT_PTYN = 10,
+    RDSPARSER_EVENT_CT = 11,
+    RDSPARSER_EVENT_COUNT
+};
+
+typedef uint8_t rdsparser_group_version_t;
+enum rdsparser_group_version
+{
+    RDSPARSER_GROUP_VERSION_A = 0,
+    RDSPARSER_GROUP_VERSION_B = 1
+};
+
+typedef uint8_t rdsparser_ring_policy_t;
+enum rdsparser_ring_policy
+{
+    RDSPARSER_RING_POLICY_DROP_NEWEST = 0,
+    RDSPARSER_RING_POLICY_DROP_OLDEST = 1,
+    RDSPARSER_RING_POLICY_BLOCK = 2
+};
+
 typedef struct librdsparser rdsparser_t;
 typedef uint16_t rdsparser_data_t[RDSPARSER_BLOCK_COUNT];
 typedef uint8_t rdsparser_error_t[RDSPARSER_BLOCK_COUNT];
@@ -352,33 +444,171 @@ enum rdsparser_country
     RDSPARSER_COUNTRY_COUNT
 };
 
+typedef struct rdsparser_stream rdsparser_stream_t;
+typedef struct rdsparser_capture rdsparser_capture_t;
+typedef struct rdsparser_sync rdsparser_sync_t;
+typedef struct rdsparser_slice rdsparser_slice_t;
+typedef struct rdsparser_manager rdsparser_manager_t;
+typedef struct rdsparser_manager_station rdsparser_manager_station_t;
+typedef struct rdsparser_engine rdsparser_engine_t;
+typedef struct rdsparser_ring rdsparser_ring_t;
+typedef struct rdsparser_ring_record rdsparser_ring_record_t;
+typedef struct rdsparser_event rdsparser_event_t;
+typedef struct rdsparser_event_queue rdsparser_event_queue_t;
 typedef struct rdsparser_af rdsparser_af_t;
 typedef struct rdsparser_ct rdsparser_ct_t;
 
 #ifndef RDSPARSER_DISABLE_UNICODE
 #include <wchar.h>
-typedef wchar_t rdsparser_string_char_t;
-#else
+#endif
+#if defined(RDSPARSER_COMPACT_STRINGS) || defined(RDSPARSER_DISABLE_UNICODE)
+/* Raw RDS codes in the compact build */
 typedef uint8_t rdsparser_string_char_t;
+#else
+typedef wchar_t rdsparser_string_char_t;
 #endif
 typedef rdsparser_string_char_t rdsparser_string_t;
 
+/* Flat event payload for the unified callback, all fields are
+   filled for every event (unused ones are zero or NULL) */
+typedef struct rdsparser_event_payload
+{
+    rdsparser_event_type_t type;
+    rdsparser_rt_flag_t flag;
+    uint8_t length;
+    uint8_t reserved;
+    int32_t value;
+    const rdsparser_string_char_t *content;
+    const rdsparser_string_error_t *errors;
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    int16_t offset;
+    uint64_t changed;
+} rdsparser_event_payload_t;
+
 #ifndef RDSPARSER_DISABLE_HEAP
 rdsparser_t* rdsparser_new(void);
 void rdsparser_free(rdsparser_t *rds);
+rdsparser_stream_t* rdsparser_stream_new(rdsparser_t *rds);
+void rdsparser_stream_free(rdsparser_stream_t *stream);
+rdsparser_sync_t* rdsparser_sync_new(rdsparser_t *rds);
+void rdsparser_sync_free(rdsparser_sync_t *sync);
+rdsparser_slice_t* rdsparser_slice_new(void);
+void rdsparser_slice_free(rdsparser_slice_t *slice);
+rdsparser_manager_t* rdsparser_manager_new(uint32_t capacity);
+void rdsparser_manager_free(rdsparser_manager_t *manager);
+rdsparser_ring_t* rdsparser_ring_new(uint32_t capacity, rdsparser_ring_policy_t policy);
+void rdsparser_ring_free(rdsparser_ring_t *ring);
+rdsparser_event_queue_t* rdsparser_event_queue_new(uint32_t capacity);
+void rdsparser_event_queue_free(rdsparser_event_queue_t *queue);
 #else
 #include <librdsparser_private.h>
 #endif
 
+#ifndef RDSPARSER_DISABLE_THREADS
+rdsparser_engine_t* rdsparser_engine_new(uint32_t channels, uint32_t threads, uint32_t queue_size);
+void rdsparser_engine_free(rdsparser_engine_t *engine);
+rdsparser_t* rdsparser_engine_get_channel(rdsparser_engine_t *engine, uint32_t channel);
+bool rdsparser_engine_start(rdsparser_engine_t *engine, bool pin);
+void rdsparser_engine_stop(rdsparser_engine_t *engine);
+bool rdsparser_engine_push(rdsparser_engine_t *engine, uint32_t channel, const rdsparser_data_t data, const rdsparser_error_t errors);
+size_t rdsparser_engine_push_batch(rdsparser_engine_t *engine, const uint32_t *channels, const rdsparser_data_t *data, const rdsparser_error_t *errors, size_t count);
+void rdsparser_engine_flush(rdsparser_engine_t *engine);
+uint32_t rdsparser_engine_get_worker(const rdsparser_engine_t *engine, uint32_t channel);
+#endif
+
 void rdsparser_init(rdsparser_t *rds);
 void rdsparser_clear(rdsparser_t *rds);
 
-void rdsparser_parse(rdsparser_t *rds, rdsparser_data_t data, rdsparser_error_t errors);
+void rdsparser_parse(rdsparser_t *rds, const rdsparser_data_t data, const rdsparser_error_t errors);
+void rdsparser_parse_batch(rdsparser_t *rds, const rdsparser_data_t *data, const rdsparser_error_t *errors, size_t count);
 bool rdsparser_parse_string(rdsparser_t *rds, const char *input);
+size_t rdsparser_convert_strings(const char *const *input, size_t count, rdsparser_data_t *data, rdsparser_error_t *errors);
+
+void rdsparser_stream_init(rdsparser_stream_t *stream, rdsparser_t *rds);
+void rdsparser_stream_reset(rdsparser_stream_t *stream);
+size_t rdsparser_stream_feed(rdsparser_stream_t *stream, const char *buffer, size_t length);
+size_t rdsparser_stream_flush(rdsparser_stream_t *stream);
+uint32_t rdsparser_stream_get_parsed(const rdsparser_stream_t *stream);
+uint32_t rdsparser_stream_get_invalid(const rdsparser_stream_t *stream);
+
+size_t rdsparser_capture_write_header(uint8_t *output, uint8_t flags);
+size_t rdsparser_capture_write_record(uint8_t *output, uint8_t flags, const rdsparser_data_t data, const rdsparser_error_t errors, uint16_t delta);
+bool rdsparser_capture_open(rdsparser_capture_t *capture, const uint8_t *buffer, size_t length);
+bool rdsparser_capture_next(rdsparser_capture_t *capture, rdsparser_data_t data, rdsparser_error_t errors, uint16_t *delta);
+size_t rdsparser_capture_parse(rdsparser_t *rds, const uint8_t *buffer, size_t length);
+bool rdsparser_capture_replay(rdsparser_t *rds, const char *path, size_t *count);
+
+size_t rdsparser_snapshot_size(void);
+size_t rdsparser_snapshot_save(const rdsparser_t *rds, uint8_t *buffer, size_t size);
+bool rdsparser_snapshot_load(rdsparser_t *rds, const uint8_t *buffer, size_t size);
+
+void rdsparser_sync_init(rdsparser_sync_t *sync, rdsparser_t *rds);
+void rdsparser_sync_reset(rdsparser_sync_t *sync);
+size_t rdsparser_sync_feed(rdsparser_sync_t *sync, const uint8_t *buffer, size_t bits);
+size_t rdsparser_sync_feed_bits(rdsparser_sync_t *sync, const uint8_t *bits, size_t count);
+bool rdsparser_sync_get_synced(const rdsparser_sync_t *sync);
+uint32_t rdsparser_sync_get_groups(const rdsparser_sync_t *sync);
+uint32_t rdsparser_sync_get_corrected(const rdsparser_sync_t *sync);
+uint32_t rdsparser_sync_get_uncorrectable(const rdsparser_sync_t *sync);
+
+void rdsparser_slice_init(rdsparser_slice_t *slice);
+void rdsparser_slice_reset(rdsparser_slice_t *slice);
+void rdsparser_slice_attach(rdsparser_slice_t *slice, uint8_t lane, rdsparser_t *rds);
+size_t rdsparser_slice_feed(rdsparser_slice_t *slice, const uint64_t *bits, size_t count);
+size_t rdsparser_slice_feed_lanes(rdsparser_slice_t *slice, const uint8_t *const *buffers, size_t bits);
+const rdsparser_sync_t* rdsparser_slice_get_lane(const rdsparser_slice_t *slice, uint8_t lane);
+
+bool rdsparser_manager_init(rdsparser_manager_t *manager, rdsparser_manager_station_t *stations, uint32_t capacity, uint32_t *table, uint32_t table_size);
+void rdsparser_manager_clear(rdsparser_manager_t *manager);
+rdsparser_t* rdsparser_manager_parse(rdsparser_manager_t *manager, const rdsparser_data_t data, const rdsparser_error_t errors);
+rdsparser_t* rdsparser_manager_find(const rdsparser_manager_t *manager, uint16_t pi);
+bool rdsparser_manager_remove(rdsparser_manager_t *manager, uint16_t pi);
+uint32_t rdsparser_manager_get_count(const rdsparser_manager_t *manager);
+rdsparser_t* rdsparser_manager_get(const rdsparser_manager_t *manager, uint32_t index);
+void rdsparser_manager_set_user_data(rdsparser_manager_t *manager, void *user_data);
+void rdsparser_manager_register_new(rdsparser_manager_t *manager, void (*callback_new)(rdsparser_t*, uint16_t, void*));
+
+bool rdsparser_ring_init(rdsparser_ring_t *ring, rdsparser_ring_record_t *records, uint32_t capacity, rdsparser_ring_policy_t policy);
+bool rdsparser_ring_push(rdsparser_ring_t *ring, const rdsparser_data_t data, const rdsparser_error_t errors);
+bool rdsparser_ring_pop(rdsparser_ring_t *ring, rdsparser_data_t data, rdsparser_error_t errors);
+size_t rdsparser_ring_parse(rdsparser_ring_t *ring, rdsparser_t *rds, size_t max);
+uint32_t rdsparser_ring_get_count(const rdsparser_ring_t *ring);
+uint32_t rdsparser_ring_get_dropped(const rdsparser_ring_t *ring);
+
+bool rdsparser_event_queue_init(rdsparser_event_queue_t *queue, rdsparser_event_t *events, uint32_t capacity);
+uint32_t rdsparser_event_queue_get_count(const rdsparser_event_queue_t *queue);
+const rdsparser_event_t* rdsparser_event_queue_peek(const rdsparser_event_queue_t *queue, uint32_t index);
+void rdsparser_event_queue_release(rdsparser_event_queue_t *queue, uint32_t count);
+uint32_t rdsparser_event_queue_get_dropped(const rdsparser_event_queue_t *queue);
+void rdsparser_attach_events(rdsparser_t *rds, rdsparser_event_queue_t *queue);
+
+rdsparser_event_type_t rdsparser_event_get_type(const rdsparser_event_t *event);
+const rdsparser_t* rdsparser_event_get_context(const rdsparser_event_t *event);
+uint32_t rdsparser_event_get_value(const rdsparser_event_t *event);
+const rdsparser_string_t* rdsparser_event_get_string(const rdsparser_event_t *event);
+const rdsparser_ct_t* rdsparser_event_get_ct(const rdsparser_event_t *event);
+uint64_t rdsparser_event_get_changed(const rdsparser_event_t *event);
 
 void rdsparser_set_extended_check(rdsparser_t *rds, bool value);
 bool rdsparser_get_extended_check(const rdsparser_t *rds);
 
+bool rdsparser_set_voting(rdsparser_t *rds, rdsparser_feature_t fields, uint8_t threshold, uint8_t window);
+uint8_t rdsparser_get_voting_threshold(const rdsparser_t *rds, rdsparser_feature_t field);
+uint8_t rdsparser_get_voting_window(const rdsparser_t *rds, rdsparser_feature_t field);
+
+void rdsparser_set_station_change(rdsparser_t *rds, uint8_t groups);
+uint8_t rdsparser_get_station_change(const rdsparser_t *rds);
+
+uint64_t rdsparser_get_repeat_lookups(const rdsparser_t *rds);
+uint64_t rdsparser_get_repeat_hits(const rdsparser_t *rds);
+
+void rdsparser_set_feature_mask(rdsparser_t *rds, rdsparser_feature_t mask);
+rdsparser_feature_t rdsparser_get_feature_mask(const rdsparser_t *rds);
+
 void rdsparser_set_text_correction(rdsparser_t *rds, rdsparser_text_t text, rdsparser_block_type_t type, rdsparser_block_error_t error);
 rdsparser_block_error_t rdsparser_get_text_correction(const rdsparser_t *rds, rdsparser_text_t text, rdsparser_block_type_t type);
 
@@ -396,6 +626,9 @@ const rdsparser_af_t* rdsparser_get_af(const rdsparser_t *rds);
 const rdsparser_string_t* rdsparser_get_ps(const rdsparser_t *rds);
 const rdsparser_string_t* rdsparser_get_rt(const rdsparser_t *rds, rdsparser_rt_flag_t flag);
 const rdsparser_string_t* rdsparser_get_ptyn(const rdsparser_t *rds);
+const rdsparser_ct_t* rdsparser_get_ct(const rdsparser_t *rds);
+
+rdsparser_change_t rdsparser_poll_changes(rdsparser_t *rds);
 
 void rdsparser_set_user_data(rdsparser_t *rds, void *user_data);
 
@@ -411,11 +644,22 @@ void rdsparser_register_ps(rdsparser_t *rds, void (*callback_ps)(rdsparser_t*, v
 void rdsparser_register_rt(rdsparser_t *rds, void (*callback_rt)(rdsparser_t*, rdsparser_rt_flag_t, void*));
 void rdsparser_register_ptyn(rdsparser_t *rds, void (*callback_ptyn)(rdsparser_t*, void*));
 void rdsparser_register_ct(rdsparser_t *rds, void (*callback_ct)(rdsparser_t*, const rdsparser_ct_t*, void*));
+void rdsparser_register_event(rdsparser_t *rds, void (*callback_event)(rdsparser_t*, rdsparser_event_type_t, const rdsparser_event_payload_t*, void*));
+bool rdsparser_register_group(rdsparser_t *rds, uint8_t group, rdsparser_group_version_t version, void (*handler)(rdsparser_t*, const rdsparser_data_t, const rdsparser_error_t, void*));
 
 uint8_t rdsparser_string_get_length(const rdsparser_string_t *string);
 bool rdsparser_string_get_available(const rdsparser_string_t *string);
+uint8_t rdsparser_string_get_available_count(const rdsparser_string_t *string);
+rdsparser_string_error_t rdsparser_string_get_min_error(const rdsparser_string_t *string);
+rdsparser_string_error_t rdsparser_string_get_max_error(const rdsparser_string_t *string);
+uint64_t rdsparser_string_get_changed(const rdsparser_string_t *string);
 const rdsparser_string_char_t* rdsparser_string_get_content(const rdsparser_string_t *string);
 const rdsparser_string_error_t* rdsparser_string_get_errors(const rdsparser_string_t *string);
+rdsparser_string_table_t rdsparser_string_get_table(const rdsparser_string_t *string);
+size_t rdsparser_string_to_utf8(const rdsparser_string_t *string, char *output, size_t size);
+#ifndef RDSPARSER_DISABLE_UNICODE
+size_t rdsparser_string_to_wchar(const rdsparser_string_t *string, wchar_t *output, size_t size);
+#endif
 
 uint16_t rdsparser_ct_get_year(const rdsparser_ct_t *ct);
 uint8_t rdsparser_ct_get_month(const rdsparser_ct_t *ct);
@@ -20,8 +20,28 @@
 #include <stdbool.h>
 #include <librdsparser.h>
 
-#define RDSPARSER_STRING_SIZE(len) (1 + (len) + 1 + \
+#define RDSPARSER_STREAM_LINE_LENGTH 18
+#define RDSPARSER_SYNC_BLOCK_BITS 26
+#define RDSPARSER_SYNC_CHECK_BITS 10
+#define RDSPARSER_RING_CACHE_LINE 64
+#define RDSPARSER_GROUP_TYPE_COUNT 32
+#define RDSPARSER_REPEAT_CACHE_BITS 4
+#define RDSPARSER_REPEAT_CACHE_SIZE (1 << RDSPARSER_REPEAT_CACHE_BITS)
+
+/* String: header, content with a terminator, the error levels
+   and the cached UTF-8 text (not in the compact build) */
+#define RDSPARSER_STRING_HEADER_SIZE ((sizeof(rdsparser_string_header_t) + sizeof(rdsparser_string_char_t) - 1) / \
+                                      sizeof(rdsparser_string_char_t))
+#define RDSPARSER_STRING_UTF8_SIZE(len) (3 * (len) + 1)
+#ifdef RDSPARSER_COMPACT_STRINGS
+#define RDSPARSER_STRING_SIZE(len) (RDSPARSER_STRING_HEADER_SIZE + (len) + 1 + \
                               (len) / sizeof(rdsparser_string_char_t))
+#else
+#define RDSPARSER_STRING_SIZE(len) (RDSPARSER_STRING_HEADER_SIZE + (len) + 1 + \
+                              (len) / sizeof(rdsparser_string_char_t) + \
+                              (RDSPARSER_STRING_UTF8_SIZE(len) + sizeof(rdsparser_string_char_t) - 1) / \
+                              sizeof(rdsparser_string_char_t))
+#endif
 
 typedef enum rdsparser_group_flag
 {
@@ -29,11 +49,42 @@ typedef enum rdsparser_group_flag
     RDSPARSER_GROUP_FLAG_B = 1
 } rdsparser_group_flag_t;
 
+typedef struct rdsparser_string_header
+{
+    uint8_t size;
+    rdsparser_string_table_t table;
+    uint8_t length;
+    uint8_t error_count[RDSPARSER_STRING_ERROR_UNCORRECTABLE + 1];
+    bool utf8_valid;
+    uint8_t utf8_length;
+    uint8_t changed[8];
+    bool changed_reset;
+} rdsparser_string_header_t;
+
+/* Index shared by two threads, accessed only as _Atomic uint32_t
+   inside the library (see src/atomic.h) */
+typedef struct rdsparser_atomic
+{
+    uint32_t value;
+} rdsparser_atomic_t;
+
+typedef void (*rdsparser_group_handler_t)(rdsparser_t*, const rdsparser_data_t, const rdsparser_error_t, void*);
+
 typedef struct rdsparser_af
 {
     uint8_t buffer[RDSPARSER_AF_BUFFER_SIZE];
 } rdsparser_af_t;
 
+typedef struct rdsparser_ct
+{
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    int8_t offset;
+} rdsparser_ct_t;
+
 typedef struct rdsparser_buffer_data
 {
     rdsparser_pi_t pi;
@@ -46,13 +97,49 @@ typedef struct rdsparser_buffer_data
     rdsparser_af_t af;
 } rdsparser_buffer_data_t;
 
+/* Voted fields: PI, PTY, TP, TA, MS, ECC (as the feature
+   bits) and the country, which follows the ECC settings */
+typedef enum rdsparser_buffer_field
+{
+    RDSPARSER_BUFFER_FIELD_PI = 0,
+    RDSPARSER_BUFFER_FIELD_PTY = 1,
+    RDSPARSER_BUFFER_FIELD_TP = 2,
+    RDSPARSER_BUFFER_FIELD_TA = 3,
+    RDSPARSER_BUFFER_FIELD_MS = 4,
+    RDSPARSER_BUFFER_FIELD_ECC = 5,
+    RDSPARSER_BUFFER_FIELD_COUNTRY = 6,
+    RDSPARSER_BUFFER_FIELD_COUNT
+} rdsparser_buffer_field_t;
+
+typedef struct rdsparser_vote
+{
+    uint8_t threshold;
+    uint8_t window;
+    uint8_t index;
+    uint8_t weight[RDSPARSER_VOTING_WINDOW_MAX];
+    uint16_t value[RDSPARSER_VOTING_WINDOW_MAX];
+} rdsparser_vote_t;
+
 typedef struct rdsparser_buffer
 {
     rdsparser_buffer_data_t data_used;
     rdsparser_buffer_data_t data_temp;
     bool extended_check;
+    rdsparser_vote_t vote[RDSPARSER_BUFFER_FIELD_COUNT];
+    bool modified;
 } rdsparser_buffer_t;
 
+/* Two-way set associative cache of groups which did not change
+   anything, at most 16 entries (one bit of the valid mask per entry) */
+typedef struct rdsparser_repeat_cache
+{
+    uint64_t group[RDSPARSER_REPEAT_CACHE_SIZE];
+    uint8_t errors[RDSPARSER_REPEAT_CACHE_SIZE];
+    uint16_t valid;
+    uint64_t lookups;
+    uint64_t hits;
+} rdsparser_repeat_cache_t;
+
 struct librdsparser
 {
     /* Data buffers */
@@ -60,10 +147,18 @@ struct librdsparser
     rdsparser_string_t ps[RDSPARSER_STRING_SIZE(RDSPARSER_PS_LENGTH)];
     rdsparser_string_t rt[RDSPARSER_RT_FLAG_COUNT][RDSPARSER_STRING_SIZE(RDSPARSER_RT_LENGTH)];
     rdsparser_string_t ptyn[RDSPARSER_STRING_SIZE(RDSPARSER_PTYN_LENGTH)];
+    rdsparser_ct_t ct;
+    bool ct_available;
+
+    /* Fields changed since the last rdsparser_poll_changes() */
+    rdsparser_change_t changes;
+    rdsparser_event_queue_t *events;
 
     /* Settings */
+    rdsparser_feature_t features;
     bool progressive[RDSPARSER_TEXT_COUNT];
     rdsparser_block_error_t correction[RDSPARSER_TEXT_COUNT][RDSPARSER_BLOCK_TYPE_COUNT];
+    uint8_t station_change;
 
     /* Callbacks */
     void *user_data;
@@ -79,9 +174,148 @@ struct librdsparser
     void (*callback_rt)(rdsparser_t*, rdsparser_rt_flag_t, void*);
     void (*callback_ptyn)(rdsparser_t*, void*);
     void (*callback_ct)(rdsparser_t*, const rdsparser_ct_t*, void*);
+    void (*callback_event)(rdsparser_t*, rdsparser_event_type_t, const rdsparser_event_payload_t*, void*);
+
+    /* Decoders indexed by the group type (group << 1 | version):
+       the enabled built-in ones and the custom ones, NULL if unhandled */
+    rdsparser_group_handler_t handler[RDSPARSER_GROUP_TYPE_COUNT];
 
     /* Other data */
     int8_t last_rt_flag;
+
+    /* Candidate PI of a new station and its consecutive occurrences */
+    rdsparser_pi_t station_pi;
+    uint8_t station_count;
+
+    /* Set by the decoders on any change outside of the buffer */
+    bool modified;
+    rdsparser_repeat_cache_t repeat;
+};
+
+struct rdsparser_stream
+{
+    rdsparser_t *rds;
+    char carry[RDSPARSER_STREAM_LINE_LENGTH + 1];
+    uint8_t carry_length;
+    bool overflow;
+    uint32_t parsed;
+    uint32_t invalid;
+};
+
+struct rdsparser_sync
+{
+    rdsparser_t *rds;
+    uint32_t reg;
+    uint32_t position;
+    uint8_t phase;
+    uint8_t fill;
+    bool synced;
+    uint8_t bit_count;
+    uint8_t block;
+    uint8_t bad_blocks;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+    uint8_t seen_offset[RDSPARSER_SYNC_BLOCK_BITS];
+    uint32_t seen_position[RDSPARSER_SYNC_BLOCK_BITS];
+    uint32_t groups;
+    uint32_t corrected;
+    uint32_t uncorrectable;
+};
+
+struct rdsparser_slice
+{
+    uint64_t history[RDSPARSER_SYNC_BLOCK_BITS * 2];
+    uint64_t syndrome[RDSPARSER_SYNC_CHECK_BITS];
+    uint64_t phase_mask[RDSPARSER_SYNC_BLOCK_BITS];
+    uint64_t active;
+    uint64_t synced;
+    uint32_t position;
+    uint8_t head;
+    uint8_t phase;
+    uint8_t fill;
+    rdsparser_sync_t lanes[RDSPARSER_SLICE_LANES];
+};
+
+struct rdsparser_manager_station
+{
+    rdsparser_t rds;
+    uint16_t pi;
+};
+
+struct rdsparser_manager
+{
+    rdsparser_manager_station_t *stations;
+    uint32_t *table;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t mask;
+    rdsparser_t *last;
+    void (*callback_new)(rdsparser_t*, uint16_t, void*);
+    void *user_data;
+};
+
+struct rdsparser_ring_record
+{
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+};
+
+struct rdsparser_ring
+{
+    /* Read-only after init */
+    rdsparser_ring_record_t *records;
+    uint32_t mask;
+    rdsparser_ring_policy_t policy;
+    uint8_t config_pad[RDSPARSER_RING_CACHE_LINE];
+
+    /* Consumer, advanced by the producer when dropping the oldest record */
+    rdsparser_atomic_t head;
+    uint8_t head_pad[RDSPARSER_RING_CACHE_LINE - sizeof(rdsparser_atomic_t)];
+
+    /* Producer */
+    rdsparser_atomic_t tail;
+    rdsparser_atomic_t dropped;
+    uint8_t tail_pad[RDSPARSER_RING_CACHE_LINE - 2 * sizeof(rdsparser_atomic_t)];
+};
+
+struct rdsparser_event
+{
+    const rdsparser_t *rds;
+    rdsparser_event_type_t type;
+    uint32_t value;
+    uint64_t changed;
+
+    /* Copy taken by the parser, the consumer never reads the context */
+    union
+    {
+        rdsparser_ct_t ct;
+        rdsparser_string_t string[RDSPARSER_STRING_SIZE(RDSPARSER_RT_LENGTH)];
+    } data;
+};
+
+struct rdsparser_event_queue
+{
+    /* Read-only after init */
+    rdsparser_event_t *events;
+    uint32_t mask;
+    uint8_t config_pad[RDSPARSER_RING_CACHE_LINE];
+
+    /* Consumer */
+    rdsparser_atomic_t head;
+    uint8_t head_pad[RDSPARSER_RING_CACHE_LINE - sizeof(rdsparser_atomic_t)];
+
+    /* Producer */
+    rdsparser_atomic_t tail;
+    rdsparser_atomic_t dropped;
+    uint8_t tail_pad[RDSPARSER_RING_CACHE_LINE - 2 * sizeof(rdsparser_atomic_t)];
+};
+
+struct rdsparser_capture
+{
+    const uint8_t *buffer;
+    size_t length;
+    size_t position;
+    uint8_t flags;
 };
 
 #endif
@@ -0,0 +1,66 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#ifndef RDSPARSER_ATOMIC_H
+#define RDSPARSER_ATOMIC_H
+#include <stdatomic.h>
+#include <librdsparser_private.h>
+
+/* The installed headers keep plain integers, so that they can be
+   included without <stdatomic.h> (e.g. from C++), and the library
+   accesses them as atomics of the same size and alignment */
+_Static_assert(sizeof(_Atomic uint32_t) == sizeof(uint32_t) &&
+               _Alignof(_Atomic uint32_t) == _Alignof(uint32_t), "uint32_t is not atomic");
+_Static_assert(sizeof(_Atomic uint16_t) == sizeof(uint16_t) &&
+               _Alignof(_Atomic uint16_t) == _Alignof(uint16_t), "uint16_t is not atomic");
+_Static_assert(sizeof(_Atomic uint8_t) == sizeof(uint8_t) &&
+               _Alignof(_Atomic uint8_t) == _Alignof(uint8_t), "uint8_t is not atomic");
+
+static inline _Atomic uint32_t*
+rdsparser_atomic(const rdsparser_atomic_t *object)
+{
+    return (_Atomic uint32_t*)&object->value;
+}
+
+/* Relaxed accesses to the records shared by the producer and the
+   consumer, validated afterwards with the indices */
+static inline uint16_t
+rdsparser_atomic_load16(const uint16_t *object)
+{
+    return atomic_load_explicit((_Atomic uint16_t*)object, memory_order_relaxed);
+}
+
+static inline void
+rdsparser_atomic_store16(uint16_t *object,
+                         uint16_t  value)
+{
+    atomic_store_explicit((_Atomic uint16_t*)object, value, memory_order_relaxed);
+}
+
+static inline uint8_t
+rdsparser_atomic_load8(const uint8_t *object)
+{
+    return atomic_load_explicit((_Atomic uint8_t*)object, memory_order_relaxed);
+}
+
+static inline void
+rdsparser_atomic_store8(uint8_t *object,
+                        uint8_t  value)
+{
+    atomic_store_explicit((_Atomic uint8_t*)object, value, memory_order_relaxed);
+}
+
+#endif
@@ -19,17 +19,77 @@
 #include "buffer.h"
 #include "af.h"
 
-#define RDSPARSER_BUFFER_UPDATE(buffer, name, value) \
-    if (buffer->data_used.name == value || \
-        (buffer->extended_check && buffer->data_temp.name != value)) \
+#define RDSPARSER_BUFFER_UPDATE(buffer, name, field, value, error) \
+    if (buffer->vote[field].threshold) \
     { \
-        buffer->data_temp.name = value; \
+        if (!rdsparser_buffer_vote(buffer, &buffer->vote[field], value, error) || \
+            buffer->data_used.name == value) \
+        { \
+            return false; \
+        } \
+    } \
+    else if (error != RDSPARSER_BLOCK_ERROR_NONE) \
+    { \
+        return false; \
+    } \
+    else if (buffer->data_used.name == value || \
+             (buffer->extended_check && buffer->data_temp.name != value)) \
+    { \
+        if (buffer->data_temp.name != value) \
+        { \
+            buffer->data_temp.name = value; \
+            buffer->modified = true; \
+        } \
         return false; \
     } \
     buffer->data_used.name = value; \
+    buffer->modified = true; \
     return true;
 
 
+static bool
+rdsparser_buffer_vote(rdsparser_buffer_t      *buffer,
+                      rdsparser_vote_t        *vote,
+                      uint16_t                 value,
+                      rdsparser_block_error_t  error)
+{
+    /* Error-free blocks have a weight of 3, corrected ones 2 or 1 */
+    const uint8_t weight = RDSPARSER_BLOCK_ERROR_UNCORRECTABLE - error;
+    bool modified = (vote->value[vote->index] != value ||
+                     vote->weight[vote->index] != weight);
+
+    vote->value[vote->index] = value;
+    vote->weight[vote->index] = weight;
+    vote->index = (uint8_t)((vote->index + 1) % vote->window);
+
+    uint8_t score = 0;
+    for (uint8_t i = 0; i < vote->window; i++)
+    {
+        if (vote->value[i] == value)
+        {
+            score += vote->weight[i];
+        }
+
+        /* The position matters, unless all votes are the same */
+        modified |= (vote->value[i] != value ||
+                     vote->weight[i] != weight);
+    }
+
+    buffer->modified |= modified;
+    return (score >= vote->threshold);
+}
+
+static void
+rdsparser_buffer_vote_clear(rdsparser_vote_t *vote)
+{
+    vote->index = 0;
+    for (uint8_t i = 0; i < RDSPARSER_VOTING_WINDOW_MAX; i++)
+    {
+        vote->weight[i] = 0;
+        vote->value[i] = 0;
+    }
+}
+
 static void
 rdsparser_buffer_data_clear(rdsparser_buffer_data_t *data)
 {
@@ -46,6 +106,12 @@ rdsparser_buffer_data_clear(rdsparser_buffer_data_t *data)
 void
 rdsparser_buffer_init(rdsparser_buffer_t *buffer)
 {
+    for (uint8_t i = 0; i < RDSPARSER_BUFFER_FIELD_COUNT; i++)
+    {
+        buffer->vote[i].threshold = 0;
+        buffer->vote[i].window = 0;
+    }
+
     rdsparser_buffer_clear(buffer);
     buffer->extended_check = false;
 }
@@ -55,6 +121,11 @@ rdsparser_buffer_clear(rdsparser_buffer_t *buffer)
 {
     rdsparser_buffer_data_clear(&buffer->data_used);
     rdsparser_buffer_data_clear(&buffer->data_temp);
+
+    for (uint8_t i = 0; i < RDSPARSER_BUFFER_FIELD_COUNT; i++)
+    {
+        rdsparser_buffer_vote_clear(&buffer->vote[i]);
+    }
 }
 
 void
@@ -70,11 +141,46 @@ rdsparser_buffer_get_extended_check(const rdsparser_buffer_t *buffer)
     return buffer->extended_check;
 }
 
+void
+rdsparser_buffer_set_voting(rdsparser_buffer_t       *buffer,
+                            rdsparser_buffer_field_t  field,
+                            uint8_t                   threshold,
+                            uint8_t                   window)
+{
+    buffer->vote[field].threshold = threshold;
+    buffer->vote[field].window = (threshold ? window : 0);
+    rdsparser_buffer_vote_clear(&buffer->vote[field]);
+}
+
+uint8_t
+rdsparser_buffer_get_voting_threshold(const rdsparser_buffer_t *buffer,
+                                      rdsparser_buffer_field_t  field)
+{
+    return buffer->vote[field].threshold;
+}
+
+uint8_t
+rdsparser_buffer_get_voting_window(const rdsparser_buffer_t *buffer,
+                                   rdsparser_buffer_field_t  field)
+{
+    return buffer->vote[field].window;
+}
+
 bool
-rdsparser_buffer_update_pi(rdsparser_buffer_t *buffer,
-                           rdsparser_pi_t      value)
+rdsparser_buffer_update_pi(rdsparser_buffer_t      *buffer,
+                           rdsparser_pi_t           value,
+                           rdsparser_block_error_t  error)
+{
+    RDSPARSER_BUFFER_UPDATE(buffer, pi, RDSPARSER_BUFFER_FIELD_PI, value, error);
+}
+
+void
+rdsparser_buffer_confirm_pi(rdsparser_buffer_t *buffer,
+                            rdsparser_pi_t      value)
 {
-    RDSPARSER_BUFFER_UPDATE(buffer, pi, value);
+    /* Already confirmed elsewhere, skip the extended check */
+    buffer->data_used.pi = value;
+    buffer->data_temp.pi = value;
 }
 
 rdsparser_pi_t
@@ -84,10 +190,11 @@ rdsparser_buffer_get_pi(const rdsparser_buffer_t *buffer)
 }
 
 bool
-rdsparser_buffer_update_pty(rdsparser_buffer_t *buffer,
-                            rdsparser_pty_t     value)
+rdsparser_buffer_update_pty(rdsparser_buffer_t      *buffer,
+                            rdsparser_pty_t          value,
+                            rdsparser_block_error_t  error)
 {
-    RDSPARSER_BUFFER_UPDATE(buffer, pty, value);
+    RDSPARSER_BUFFER_UPDATE(buffer, pty, RDSPARSER_BUFFER_FIELD_PTY, value, error);
 }
 
 rdsparser_pty_t
@@ -97,10 +204,11 @@ rdsparser_buffer_get_pty(const rdsparser_buffer_t *buffer)
 }
 
 bool
-rdsparser_buffer_update_tp(rdsparser_buffer_t *buffer,
-                           rdsparser_tp_t      value)
+rdsparser_buffer_update_tp(rdsparser_buffer_t      *buffer,
+                           rdsparser_tp_t           value,
+                           rdsparser_block_error_t  error)
 {
-    RDSPARSER_BUFFER_UPDATE(buffer, tp, value);
+    RDSPARSER_BUFFER_UPDATE(buffer, tp, RDSPARSER_BUFFER_FIELD_TP, value, error);
 }
 
 rdsparser_tp_t
@@ -110,10 +218,11 @@ rdsparser_buffer_get_tp(const rdsparser_buffer_t *buffer)
 }
 
 bool
-rdsparser_buffer_update_ta(rdsparser_buffer_t *buffer,
-                           rdsparser_ta_t      value)
+rdsparser_buffer_update_ta(rdsparser_buffer_t      *buffer,
+                           rdsparser_ta_t           value,
+                           rdsparser_block_error_t  error)
 {
-    RDSPARSER_BUFFER_UPDATE(buffer, ta, value);
+    RDSPARSER_BUFFER_UPDATE(buffer, ta, RDSPARSER_BUFFER_FIELD_TA, value, error);
 }
 
 rdsparser_ta_t
@@ -123,10 +232,11 @@ rdsparser_buffer_get_ta(const rdsparser_buffer_t *buffer)
 }
 
 bool
-rdsparser_buffer_update_ms(rdsparser_buffer_t *buffer,
-                           rdsparser_ms_t      value)
+rdsparser_buffer_update_ms(rdsparser_buffer_t      *buffer,
+                           rdsparser_ms_t           value,
+                           rdsparser_block_error_t  error)
 {
-    RDSPARSER_BUFFER_UPDATE(buffer, ms, value);
+    RDSPARSER_BUFFER_UPDATE(buffer, ms, RDSPARSER_BUFFER_FIELD_MS, value, error);
 }
 
 rdsparser_ms_t
@@ -136,10 +246,11 @@ rdsparser_buffer_get_ms(const rdsparser_buffer_t *buffer)
 }
 
 bool
-rdsparser_buffer_update_ecc(rdsparser_buffer_t *buffer,
-                            rdsparser_ecc_t     value)
+rdsparser_buffer_update_ecc(rdsparser_buffer_t      *buffer,
+                            rdsparser_ecc_t          value,
+                            rdsparser_block_error_t  error)
 {
-    RDSPARSER_BUFFER_UPDATE(buffer, ecc, value);
+    RDSPARSER_BUFFER_UPDATE(buffer, ecc, RDSPARSER_BUFFER_FIELD_ECC, value, error);
 }
 
 rdsparser_ecc_t
@@ -149,10 +260,11 @@ rdsparser_buffer_get_ecc(const rdsparser_buffer_t *buffer)
 }
 
 bool
-rdsparser_buffer_update_country(rdsparser_buffer_t  *buffer,
-                                rdsparser_country_t  value)
+rdsparser_buffer_update_country(rdsparser_buffer_t      *buffer,
+                                rdsparser_country_t      value,
+                                rdsparser_block_error_t  error)
 {
-    RDSPARSER_BUFFER_UPDATE(buffer, country, value);
+    RDSPARSER_BUFFER_UPDATE(buffer, country, RDSPARSER_BUFFER_FIELD_COUNTRY, value, error);
 }
 
 rdsparser_country_t
@@ -170,11 +282,13 @@ rdsparser_buffer_add_af(rdsparser_buffer_t *buffer,
         if (buffer->extended_check && 
             !rdsparser_af_get(&buffer->data_temp.af, value))
         {
-            rdsparser_af_set(&buffer->data_temp.af, value);
+            buffer->modified |= rdsparser_af_set(&buffer->data_temp.af, value);
             return false;
         }
 
-        return rdsparser_af_set(&buffer->data_used.af, value);
+        const bool added = rdsparser_af_set(&buffer->data_used.af, value);
+        buffer->modified |= added;
+        return added;
     }
     
     return false;
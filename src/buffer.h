@@ -24,25 +24,30 @@ void rdsparser_buffer_clear(rdsparser_buffer_t *buffer);
 void rdsparser_buffer_set_extended_check(rdsparser_buffer_t *buffer, bool value);
 bool rdsparser_buffer_get_extended_check(const rdsparser_buffer_t *buffer);
 
-bool rdsparser_buffer_update_pi(rdsparser_buffer_t *buffer, rdsparser_pi_t value);
+void rdsparser_buffer_set_voting(rdsparser_buffer_t *buffer, rdsparser_buffer_field_t field, uint8_t threshold, uint8_t window);
+uint8_t rdsparser_buffer_get_voting_threshold(const rdsparser_buffer_t *buffer, rdsparser_buffer_field_t field);
+uint8_t rdsparser_buffer_get_voting_window(const rdsparser_buffer_t *buffer, rdsparser_buffer_field_t field);
+
+bool rdsparser_buffer_update_pi(rdsparser_buffer_t *buffer, rdsparser_pi_t value, rdsparser_block_error_t error);
+void rdsparser_buffer_confirm_pi(rdsparser_buffer_t *buffer, rdsparser_pi_t value);
 rdsparser_pi_t rdsparser_buffer_get_pi(const rdsparser_buffer_t *buffer);
 
-bool rdsparser_buffer_update_pty(rdsparser_buffer_t *buffer, rdsparser_pty_t value);
+bool rdsparser_buffer_update_pty(rdsparser_buffer_t *buffer, rdsparser_pty_t value, rdsparser_block_error_t error);
 rdsparser_pty_t rdsparser_buffer_get_pty(const rdsparser_buffer_t *buffer);
 
-bool rdsparser_buffer_update_tp(rdsparser_buffer_t *buffer, rdsparser_tp_t value);
+bool rdsparser_buffer_update_tp(rdsparser_buffer_t *buffer, rdsparser_tp_t value, rdsparser_block_error_t error);
 rdsparser_tp_t rdsparser_buffer_get_tp(const rdsparser_buffer_t *buffer);
 
-bool rdsparser_buffer_update_ta(rdsparser_buffer_t *buffer, rdsparser_ta_t value);
+bool rdsparser_buffer_update_ta(rdsparser_buffer_t *buffer, rdsparser_ta_t value, rdsparser_block_error_t error);
 rdsparser_ta_t rdsparser_buffer_get_ta(const rdsparser_buffer_t *buffer);
 
-bool rdsparser_buffer_update_ms(rdsparser_buffer_t *buffer, rdsparser_ms_t value);
+bool rdsparser_buffer_update_ms(rdsparser_buffer_t *buffer, rdsparser_ms_t value, rdsparser_block_error_t error);
 rdsparser_ms_t rdsparser_buffer_get_ms(const rdsparser_buffer_t *buffer);
 
-bool rdsparser_buffer_update_ecc(rdsparser_buffer_t *buffer, rdsparser_ecc_t value);
+bool rdsparser_buffer_update_ecc(rdsparser_buffer_t *buffer, rdsparser_ecc_t value, rdsparser_block_error_t error);
 rdsparser_ecc_t rdsparser_buffer_get_ecc(const rdsparser_buffer_t *buffer);
 
-bool rdsparser_buffer_update_country(rdsparser_buffer_t *buffer, rdsparser_country_t value);
+bool rdsparser_buffer_update_country(rdsparser_buffer_t *buffer, rdsparser_country_t value, rdsparser_block_error_t error);
 rdsparser_country_t rdsparser_buffer_get_country(const rdsparser_buffer_t *buffer);
 
 bool rdsparser_buffer_add_af(rdsparser_buffer_t *buffer, uint8_t value);
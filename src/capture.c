@@ -0,0 +1,273 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdint.h>
+#include <librdsparser_private.h>
+#include "parser.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define RDSPARSER_CAPTURE_MMAP
+#endif
+
+#define RDSPARSER_CAPTURE_VERSION 1
+
+/* Header: "RDSC" magic, version, flags and two reserved bytes.
+ * Record: blocks A-D as big-endian words, error byte in NXP order
+ * and an optional big-endian time delta (in milliseconds). */
+static const uint8_t rdsparser_capture_magic[4] = { 'R', 'D', 'S', 'C' };
+
+static inline size_t
+rdsparser_capture_get_record_size(uint8_t flags)
+{
+    return RDSPARSER_CAPTURE_RECORD_SIZE +
+           ((flags & RDSPARSER_CAPTURE_FLAG_DELTA) ? RDSPARSER_CAPTURE_DELTA_SIZE : 0);
+}
+
+size_t
+rdsparser_capture_write_header(uint8_t *output,
+                               uint8_t  flags)
+{
+    for (uint8_t i = 0; i < sizeof(rdsparser_capture_magic); i++)
+    {
+        output[i] = rdsparser_capture_magic[i];
+    }
+
+    output[4] = RDSPARSER_CAPTURE_VERSION;
+    output[5] = flags & RDSPARSER_CAPTURE_FLAG_DELTA;
+    output[6] = 0;
+    output[7] = 0;
+    return RDSPARSER_CAPTURE_HEADER_SIZE;
+}
+
+size_t
+rdsparser_capture_write_record(uint8_t                 *output,
+                               uint8_t                  flags,
+                               const rdsparser_data_t   data,
+                               const rdsparser_error_t  errors,
+                               uint16_t                 delta)
+{
+    for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+    {
+        output[block * 2] = (uint8_t)(data[block] >> 8);
+        output[block * 2 + 1] = (uint8_t)(data[block] & 0xFF);
+    }
+
+    output[8] = (uint8_t)(((errors[RDSPARSER_BLOCK_A] & 3) << 6) |
+                          ((errors[RDSPARSER_BLOCK_B] & 3) << 4) |
+                          ((errors[RDSPARSER_BLOCK_C] & 3) << 2) |
+                          (errors[RDSPARSER_BLOCK_D] & 3));
+
+    if (flags & RDSPARSER_CAPTURE_FLAG_DELTA)
+    {
+        output[9] = (uint8_t)(delta >> 8);
+        output[10] = (uint8_t)(delta & 0xFF);
+    }
+
+    return rdsparser_capture_get_record_size(flags);
+}
+
+bool
+rdsparser_capture_open(rdsparser_capture_t *capture,
+                       const uint8_t       *buffer,
+                       size_t               length)
+{
+    /* An empty capture on failure, so it is never read uninitialized */
+    capture->buffer = NULL;
+    capture->length = 0;
+    capture->position = 0;
+    capture->flags = 0;
+
+    if (buffer == NULL ||
+        length < RDSPARSER_CAPTURE_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < sizeof(rdsparser_capture_magic); i++)
+    {
+        if (buffer[i] != rdsparser_capture_magic[i])
+        {
+            return false;
+        }
+    }
+
+    if (buffer[4] != RDSPARSER_CAPTURE_VERSION)
+    {
+        return false;
+    }
+
+    capture->buffer = buffer;
+    capture->length = length;
+    capture->position = RDSPARSER_CAPTURE_HEADER_SIZE;
+    capture->flags = buffer[5];
+    return true;
+}
+
+bool
+rdsparser_capture_next(rdsparser_capture_t *capture,
+                       rdsparser_data_t     data,
+                       rdsparser_error_t    errors,
+                       uint16_t            *delta)
+{
+    const size_t size = rdsparser_capture_get_record_size(capture->flags);
+
+    if (capture->length - capture->position < size)
+    {
+        /* End of capture, a truncated record is ignored */
+        return false;
+    }
+
+    const uint8_t *record = capture->buffer + capture->position;
+    capture->position += size;
+
+    for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+    {
+        data[block] = (uint16_t)((record[block * 2] << 8) | record[block * 2 + 1]);
+    }
+
+    errors[RDSPARSER_BLOCK_A] = (record[8] & 192) >> 6;
+    errors[RDSPARSER_BLOCK_B] = (record[8] & 48) >> 4;
+    errors[RDSPARSER_BLOCK_C] = (record[8] & 12) >> 2;
+    errors[RDSPARSER_BLOCK_D] = (record[8] & 3);
+
+    if (delta)
+    {
+        *delta = (capture->flags & RDSPARSER_CAPTURE_FLAG_DELTA)
+                 ? (uint16_t)((record[9] << 8) | record[10])
+                 : 0;
+    }
+
+    return true;
+}
+
+static bool
+rdsparser_capture_process(rdsparser_t   *rds,
+                          const uint8_t *buffer,
+                          size_t         length,
+                          size_t        *count)
+{
+    rdsparser_capture_t capture;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    if (!rdsparser_capture_open(&capture, buffer, length))
+    {
+        return false;
+    }
+
+    while (rdsparser_capture_next(&capture, data, errors, NULL))
+    {
+        rdsparser_parser_process(rds, data, errors);
+        (*count)++;
+    }
+
+    return true;
+}
+
+size_t
+rdsparser_capture_parse(rdsparser_t   *rds,
+                        const uint8_t *buffer,
+                        size_t         length)
+{
+    size_t count = 0;
+    rdsparser_capture_process(rds, buffer, length, &count);
+    return count;
+}
+
+bool
+rdsparser_capture_replay(rdsparser_t *rds,
+                         const char  *path,
+                         size_t      *count)
+{
+    size_t parsed = 0;
+    bool success = false;
+
+    if (count)
+    {
+        *count = 0;
+    }
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) &&
+        size.QuadPart >= RDSPARSER_CAPTURE_HEADER_SIZE &&
+        (uint64_t)size.QuadPart <= (uint64_t)SIZE_MAX)
+    {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping)
+        {
+            const uint8_t *buffer = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (buffer)
+            {
+                success = rdsparser_capture_process(rds, buffer, (size_t)size.QuadPart, &parsed);
+                UnmapViewOfFile(buffer);
+            }
+            CloseHandle(mapping);
+        }
+    }
+
+    CloseHandle(file);
+#elif defined(RDSPARSER_CAPTURE_MMAP)
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 &&
+        st.st_size >= RDSPARSER_CAPTURE_HEADER_SIZE &&
+        (uint64_t)st.st_size <= (uint64_t)SIZE_MAX)
+    {
+        const size_t length = (size_t)st.st_size;
+        void *buffer = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (buffer != MAP_FAILED)
+        {
+#ifdef MADV_SEQUENTIAL
+            madvise(buffer, length, MADV_SEQUENTIAL);
+#endif
+            success = rdsparser_capture_process(rds, buffer, length, &parsed);
+            munmap(buffer, length);
+        }
+    }
+
+    close(fd);
+#else
+    (void)rds;
+    (void)path;
+#endif
+
+    if (count)
+    {
+        *count = parsed;
+    }
+
+    return success;
+}
@@ -16,17 +16,7 @@
 
 #ifndef RDSPARSER_CT_H
 #define RDSPARSER_CT_H
-#include <librdsparser.h>
-
-typedef struct rdsparser_ct
-{
-    uint16_t year;
-    uint8_t month;
-    uint8_t day;
-    uint8_t hour;
-    uint8_t minute;
-    int8_t offset;
-} rdsparser_ct_t;
+#include <librdsparser_private.h>
 
 bool rdsparser_ct_init(rdsparser_ct_t *ct, uint32_t mjd, int8_t hour, int8_t minute, int8_t offset);
 
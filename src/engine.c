@@ -0,0 +1,458 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#if defined(__linux__) && !defined(RDSPARSER_DISABLE_THREADS)
+#define _GNU_SOURCE
+#include <sched.h>
+#include <unistd.h>
+#endif
+#include <stdint.h>
+#include <librdsparser_private.h>
+
+#ifndef RDSPARSER_DISABLE_THREADS
+#include <pthread.h>
+#include "parser.h"
+
+/* Groups taken from the queue at once, processed outside the lock */
+#define RDSPARSER_ENGINE_CHUNK 64
+
+/* Groups of a batch bucketed by worker at once */
+#define RDSPARSER_ENGINE_BATCH 256
+
+typedef struct rdsparser_engine_item
+{
+    uint32_t channel;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+} rdsparser_engine_item_t;
+
+typedef struct rdsparser_engine_worker
+{
+    rdsparser_engine_t *engine;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    pthread_cond_t idle;
+    rdsparser_engine_item_t *queue;
+    uint32_t head;
+    uint32_t count;
+    bool busy;
+    bool stopping;
+} rdsparser_engine_worker_t;
+
+struct rdsparser_engine
+{
+    rdsparser_t *channels;
+    uint32_t channel_count;
+    rdsparser_engine_worker_t *workers;
+    uint32_t thread_count;
+    uint32_t queue_size;
+    bool running;
+};
+
+rdsparser_engine_t*
+rdsparser_engine_new(uint32_t channels,
+                     uint32_t threads,
+                     uint32_t queue_size)
+{
+    if (channels == 0 ||
+        threads == 0 ||
+        queue_size == 0)
+    {
+        return NULL;
+    }
+
+    rdsparser_engine_t *engine = calloc(1, sizeof(rdsparser_engine_t));
+    if (engine == NULL)
+    {
+        return NULL;
+    }
+
+    engine->channels = malloc(sizeof(rdsparser_t) * channels);
+    engine->workers = calloc(threads, sizeof(rdsparser_engine_worker_t));
+    if (engine->channels == NULL ||
+        engine->workers == NULL)
+    {
+        rdsparser_engine_free(engine);
+        return NULL;
+    }
+
+    engine->channel_count = channels;
+    engine->thread_count = threads;
+    engine->queue_size = queue_size;
+
+    for (uint32_t i = 0; i < channels; i++)
+    {
+        rdsparser_init(&engine->channels[i]);
+    }
+
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        rdsparser_engine_worker_t *worker = &engine->workers[i];
+        worker->engine = engine;
+        worker->queue = malloc(sizeof(rdsparser_engine_item_t) * queue_size);
+        if (worker->queue == NULL)
+        {
+            rdsparser_engine_free(engine);
+            return NULL;
+        }
+
+        pthread_mutex_init(&worker->mutex, NULL);
+        pthread_cond_init(&worker->not_empty, NULL);
+        pthread_cond_init(&worker->not_full, NULL);
+        pthread_cond_init(&worker->idle, NULL);
+    }
+
+    return engine;
+}
+
+void
+rdsparser_engine_free(rdsparser_engine_t *engine)
+{
+    if (engine == NULL)
+    {
+        return;
+    }
+
+    rdsparser_engine_stop(engine);
+
+    if (engine->workers)
+    {
+        for (uint32_t i = 0; i < engine->thread_count; i++)
+        {
+            rdsparser_engine_worker_t *worker = &engine->workers[i];
+            if (worker->queue)
+            {
+                pthread_mutex_destroy(&worker->mutex);
+                pthread_cond_destroy(&worker->not_empty);
+                pthread_cond_destroy(&worker->not_full);
+                pthread_cond_destroy(&worker->idle);
+                free(worker->queue);
+            }
+        }
+    }
+
+    free(engine->workers);
+    free(engine->channels);
+    free(engine);
+}
+
+rdsparser_t*
+rdsparser_engine_get_channel(rdsparser_engine_t *engine,
+                             uint32_t            channel)
+{
+    return (channel < engine->channel_count) ? &engine->channels[channel] : NULL;
+}
+
+uint32_t
+rdsparser_engine_get_worker(const rdsparser_engine_t *engine,
+                            uint32_t                  channel)
+{
+    /* Each channel is always handled by the same worker */
+    return channel % engine->thread_count;
+}
+
+static void*
+rdsparser_engine_run(void *arg)
+{
+    rdsparser_engine_worker_t *worker = arg;
+    rdsparser_engine_t *engine = worker->engine;
+    rdsparser_engine_item_t items[RDSPARSER_ENGINE_CHUNK];
+
+    pthread_mutex_lock(&worker->mutex);
+    while (true)
+    {
+        while (worker->count == 0 &&
+               !worker->stopping)
+        {
+            pthread_cond_wait(&worker->not_empty, &worker->mutex);
+        }
+
+        if (worker->count == 0)
+        {
+            /* Stopping and drained */
+            break;
+        }
+
+        uint32_t count = 0;
+        while (count < RDSPARSER_ENGINE_CHUNK &&
+               worker->count)
+        {
+            items[count++] = worker->queue[worker->head];
+            worker->head = (worker->head + 1 == engine->queue_size) ? 0 : worker->head + 1;
+            worker->count--;
+        }
+
+        worker->busy = true;
+        pthread_cond_broadcast(&worker->not_full);
+        pthread_mutex_unlock(&worker->mutex);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            rdsparser_parser_process(&engine->channels[items[i].channel], items[i].data, items[i].errors);
+        }
+
+        pthread_mutex_lock(&worker->mutex);
+        worker->busy = false;
+        if (worker->count == 0)
+        {
+            pthread_cond_broadcast(&worker->idle);
+        }
+    }
+
+    pthread_mutex_unlock(&worker->mutex);
+    return NULL;
+}
+
+static void
+rdsparser_engine_pin(rdsparser_engine_worker_t *worker,
+                     uint32_t                   index)
+{
+#ifdef __linux__
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus > 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET((int)(index % (uint32_t)cpus), &set);
+        pthread_setaffinity_np(worker->thread, sizeof(set), &set);
+    }
+#else
+    (void)worker;
+    (void)index;
+#endif
+}
+
+static void
+rdsparser_engine_join(rdsparser_engine_t *engine,
+                      uint32_t            count)
+{
+    /* Only the first count workers are running */
+    for (uint32_t i = 0; i < count; i++)
+    {
+        rdsparser_engine_worker_t *worker = &engine->workers[i];
+        pthread_mutex_lock(&worker->mutex);
+        worker->stopping = true;
+        pthread_cond_signal(&worker->not_empty);
+        pthread_mutex_unlock(&worker->mutex);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        pthread_join(engine->workers[i].thread, NULL);
+    }
+}
+
+bool
+rdsparser_engine_start(rdsparser_engine_t *engine,
+                       bool                pin)
+{
+    if (engine->running)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < engine->thread_count; i++)
+    {
+        rdsparser_engine_worker_t *worker = &engine->workers[i];
+        worker->stopping = false;
+
+        if (pthread_create(&worker->thread, NULL, rdsparser_engine_run, worker) != 0)
+        {
+            /* Roll back the already started workers */
+            rdsparser_engine_join(engine, i);
+            return false;
+        }
+
+        if (pin)
+        {
+            rdsparser_engine_pin(worker, i);
+        }
+    }
+
+    engine->running = true;
+    return true;
+}
+
+void
+rdsparser_engine_stop(rdsparser_engine_t *engine)
+{
+    if (!engine->running)
+    {
+        return;
+    }
+
+    rdsparser_engine_join(engine, engine->thread_count);
+    engine->running = false;
+}
+
+static void
+rdsparser_engine_enqueue(rdsparser_engine_worker_t *worker,
+                         uint32_t                   channel,
+                         const rdsparser_data_t     data,
+                         const rdsparser_error_t    errors)
+{
+    const uint32_t queue_size = worker->engine->queue_size;
+
+    /* Block the producer while the queue is full, this keeps the order */
+    while (worker->count == queue_size)
+    {
+        pthread_cond_wait(&worker->not_full, &worker->mutex);
+    }
+
+    uint32_t tail = worker->head + worker->count;
+    if (tail >= queue_size)
+    {
+        tail -= queue_size;
+    }
+
+    rdsparser_engine_item_t *item = &worker->queue[tail];
+    item->channel = channel;
+    for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+    {
+        item->data[block] = data[block];
+        item->errors[block] = errors[block];
+    }
+
+    if (worker->count++ == 0)
+    {
+        pthread_cond_signal(&worker->not_empty);
+    }
+}
+
+bool
+rdsparser_engine_push(rdsparser_engine_t      *engine,
+                      uint32_t                 channel,
+                      const rdsparser_data_t   data,
+                      const rdsparser_error_t  errors)
+{
+    if (!engine->running ||
+        channel >= engine->channel_count)
+    {
+        return false;
+    }
+
+    rdsparser_engine_worker_t *worker = &engine->workers[rdsparser_engine_get_worker(engine, channel)];
+    pthread_mutex_lock(&worker->mutex);
+    rdsparser_engine_enqueue(worker, channel, data, errors);
+    pthread_mutex_unlock(&worker->mutex);
+    return true;
+}
+
+size_t
+rdsparser_engine_push_batch(rdsparser_engine_t      *engine,
+                            const uint32_t          *channels,
+                            const rdsparser_data_t  *data,
+                            const rdsparser_error_t *errors,
+                            size_t                   count)
+{
+    size_t pushed = 0;
+
+    if (!engine->running)
+    {
+        return 0;
+    }
+
+    const uint32_t threads = engine->thread_count;
+    uint32_t owner[RDSPARSER_ENGINE_BATCH];
+    uint32_t order[RDSPARSER_ENGINE_BATCH];
+    uint32_t start[threads];
+
+    for (size_t offset = 0; offset < count; offset += RDSPARSER_ENGINE_BATCH)
+    {
+        const size_t chunk = (count - offset < RDSPARSER_ENGINE_BATCH ? count - offset : RDSPARSER_ENGINE_BATCH);
+        uint32_t valid = 0;
+
+        for (uint32_t i = 0; i < threads; i++)
+        {
+            start[i] = 0;
+        }
+
+        /* Find the worker of each group once and count the groups */
+        for (size_t j = 0; j < chunk; j++)
+        {
+            const uint32_t channel = channels[offset + j];
+            owner[j] = (channel < engine->channel_count ? rdsparser_engine_get_worker(engine, channel) : threads);
+            if (owner[j] < threads)
+            {
+                start[owner[j]]++;
+                valid++;
+            }
+        }
+
+        for (uint32_t i = 1; i < threads; i++)
+        {
+            start[i] += start[i - 1];
+        }
+
+        /* Stable bucketing by worker, backwards from the bucket ends,
+           so the order within a channel is kept */
+        for (size_t j = chunk; j-- > 0; )
+        {
+            if (owner[j] < threads)
+            {
+                order[--start[owner[j]]] = (uint32_t)j;
+            }
+        }
+
+        /* Take each worker lock once per chunk, only if it has groups */
+        for (uint32_t i = 0; i < threads; i++)
+        {
+            const uint32_t last = (i + 1 < threads ? start[i + 1] : valid);
+            if (start[i] == last)
+            {
+                continue;
+            }
+
+            rdsparser_engine_worker_t *worker = &engine->workers[i];
+            pthread_mutex_lock(&worker->mutex);
+            for (uint32_t k = start[i]; k < last; k++)
+            {
+                const size_t j = offset + order[k];
+                rdsparser_engine_enqueue(worker, channels[j], data[j], errors[j]);
+            }
+            pthread_mutex_unlock(&worker->mutex);
+        }
+
+        pushed += valid;
+    }
+
+    return pushed;
+}
+
+void
+rdsparser_engine_flush(rdsparser_engine_t *engine)
+{
+    if (!engine->running)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < engine->thread_count; i++)
+    {
+        rdsparser_engine_worker_t *worker = &engine->workers[i];
+        pthread_mutex_lock(&worker->mutex);
+        while (worker->count ||
+               worker->busy)
+        {
+            pthread_cond_wait(&worker->idle, &worker->mutex);
+        }
+        pthread_mutex_unlock(&worker->mutex);
+    }
+}
+#endif
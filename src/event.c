@@ -0,0 +1,270 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#include <stdint.h>
+#include <librdsparser_private.h>
+#include "atomic.h"
+#include "event.h"
+
+#ifndef RDSPARSER_DISABLE_HEAP
+rdsparser_event_queue_t*
+rdsparser_event_queue_new(uint32_t capacity)
+{
+    rdsparser_event_queue_t *queue = malloc(sizeof(rdsparser_event_queue_t));
+    rdsparser_event_t *events = malloc(sizeof(rdsparser_event_t) * capacity);
+
+    if (queue == NULL ||
+        events == NULL ||
+        !rdsparser_event_queue_init(queue, events, capacity))
+    {
+        free(queue);
+        free(events);
+        return NULL;
+    }
+
+    return queue;
+}
+
+void
+rdsparser_event_queue_free(rdsparser_event_queue_t *queue)
+{
+    if (queue)
+    {
+        free(queue->events);
+        free(queue);
+    }
+}
+#endif
+
+bool
+rdsparser_event_queue_init(rdsparser_event_queue_t *queue,
+                           rdsparser_event_t       *events,
+                           uint32_t                 capacity)
+{
+    /* The capacity must be a power of two */
+    if (events == NULL ||
+        capacity == 0 ||
+        (capacity & (capacity - 1)))
+    {
+        return false;
+    }
+
+    queue->events = events;
+    queue->mask = capacity - 1;
+    atomic_init(rdsparser_atomic(&queue->head), 0);
+    atomic_init(rdsparser_atomic(&queue->tail), 0);
+    atomic_init(rdsparser_atomic(&queue->dropped), 0);
+    return true;
+}
+
+static const rdsparser_string_t*
+rdsparser_event_get_source(const rdsparser_t      *rds,
+                           rdsparser_event_type_t  type,
+                           uint32_t                value)
+{
+    switch (type)
+    {
+        case RDSPARSER_EVENT_PS:
+            return rds->ps;
+
+        case RDSPARSER_EVENT_RT:
+            return rds->rt[!!value];
+
+        case RDSPARSER_EVENT_PTYN:
+            return rds->ptyn;
+
+        default:
+            return NULL;
+    }
+}
+
+void
+rdsparser_event_push(rdsparser_t            *rds,
+                     rdsparser_event_type_t  type,
+                     uint32_t                value)
+{
+    rdsparser_event_queue_t *queue = rds->events;
+    const uint32_t tail = atomic_load_explicit(rdsparser_atomic(&queue->tail), memory_order_relaxed);
+    const uint32_t head = atomic_load_explicit(rdsparser_atomic(&queue->head), memory_order_acquire);
+
+    if (tail - head > queue->mask)
+    {
+        /* Never wait for the consumer in the parser */
+        atomic_fetch_add_explicit(rdsparser_atomic(&queue->dropped), 1, memory_order_relaxed);
+        return;
+    }
+
+    rdsparser_event_t *event = &queue->events[tail & queue->mask];
+    event->rds = rds;
+    event->type = type;
+    event->value = value;
+    event->changed = 0;
+    if (type == RDSPARSER_EVENT_CT)
+    {
+        event->data.ct = rds->ct;
+    }
+
+    const rdsparser_string_t *string = rdsparser_event_get_source(rds, type, value);
+    if (string)
+    {
+        /* The whole string object (including the cached UTF-8 text) is
+           copied, as the parser keeps updating the context meanwhile */
+        const size_t size = RDSPARSER_STRING_SIZE(((const rdsparser_string_header_t*)string)->size);
+        for (size_t i = 0; i < size; i++)
+        {
+            event->data.string[i] = string[i];
+        }
+        event->changed = rdsparser_string_get_changed(string);
+    }
+
+    atomic_store_explicit(rdsparser_atomic(&queue->tail), tail + 1, memory_order_release);
+}
+
+void
+rdsparser_event_call(rdsparser_t            *rds,
+                     rdsparser_event_type_t  type,
+                     uint32_t                value)
+{
+    rdsparser_event_payload_t payload = { 0 };
+    const rdsparser_string_t *string = rdsparser_event_get_source(rds, type, value);
+
+    payload.type = type;
+    payload.value = (int32_t)value;
+
+    switch (type)
+    {
+        case RDSPARSER_EVENT_RT:
+            payload.flag = (rdsparser_rt_flag_t)value;
+            break;
+
+        case RDSPARSER_EVENT_CT:
+            payload.year = rds->ct.year;
+            payload.month = rds->ct.month;
+            payload.day = rds->ct.day;
+            payload.hour = rds->ct.hour;
+            payload.minute = rds->ct.minute;
+            payload.offset = rdsparser_ct_get_offset(&rds->ct);
+            break;
+
+        default:
+            break;
+    }
+
+    if (string)
+    {
+        payload.length = rdsparser_string_get_length(string);
+        payload.content = rdsparser_string_get_content(string);
+        payload.errors = rdsparser_string_get_errors(string);
+        payload.changed = rdsparser_string_get_changed(string);
+    }
+
+    rds->callback_event(rds, type, &payload, rds->user_data);
+}
+
+uint32_t
+rdsparser_event_queue_get_count(const rdsparser_event_queue_t *queue)
+{
+    const uint32_t head = atomic_load_explicit(rdsparser_atomic(&queue->head), memory_order_relaxed);
+    const uint32_t tail = atomic_load_explicit(rdsparser_atomic(&queue->tail), memory_order_acquire);
+    return tail - head;
+}
+
+const rdsparser_event_t*
+rdsparser_event_queue_peek(const rdsparser_event_queue_t *queue,
+                           uint32_t                       index)
+{
+    const uint32_t head = atomic_load_explicit(rdsparser_atomic(&queue->head), memory_order_relaxed);
+
+    if (index >= rdsparser_event_queue_get_count(queue))
+    {
+        return NULL;
+    }
+
+    return &queue->events[(head + index) & queue->mask];
+}
+
+void
+rdsparser_event_queue_release(rdsparser_event_queue_t *queue,
+                              uint32_t                 count)
+{
+    const uint32_t available = rdsparser_event_queue_get_count(queue);
+    const uint32_t head = atomic_load_explicit(rdsparser_atomic(&queue->head), memory_order_relaxed);
+
+    if (count > available)
+    {
+        count = available;
+    }
+
+    atomic_store_explicit(rdsparser_atomic(&queue->head), head + count, memory_order_release);
+}
+
+uint32_t
+rdsparser_event_queue_get_dropped(const rdsparser_event_queue_t *queue)
+{
+    return atomic_load_explicit(rdsparser_atomic(&queue->dropped), memory_order_relaxed);
+}
+
+void
+rdsparser_attach_events(rdsparser_t             *rds,
+                        rdsparser_event_queue_t *queue)
+{
+    rds->events = queue;
+}
+
+rdsparser_event_type_t
+rdsparser_event_get_type(const rdsparser_event_t *event)
+{
+    return event->type;
+}
+
+const rdsparser_t*
+rdsparser_event_get_context(const rdsparser_event_t *event)
+{
+    return event->rds;
+}
+
+uint32_t
+rdsparser_event_get_value(const rdsparser_event_t *event)
+{
+    return event->value;
+}
+
+const rdsparser_string_t*
+rdsparser_event_get_string(const rdsparser_event_t *event)
+{
+    switch (event->type)
+    {
+        case RDSPARSER_EVENT_PS:
+        case RDSPARSER_EVENT_RT:
+        case RDSPARSER_EVENT_PTYN:
+            return event->data.string;
+
+        default:
+            return NULL;
+    }
+}
+
+const rdsparser_ct_t*
+rdsparser_event_get_ct(const rdsparser_event_t *event)
+{
+    return (event->type == RDSPARSER_EVENT_CT ? &event->data.ct : NULL);
+}
+
+uint64_t
+rdsparser_event_get_changed(const rdsparser_event_t *event)
+{
+    return event->changed;
+}
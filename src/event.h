@@ -0,0 +1,40 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#ifndef RDSPARSER_EVENT_H
+#define RDSPARSER_EVENT_H
+#include <librdsparser_private.h>
+
+void rdsparser_event_push(rdsparser_t *rds, rdsparser_event_type_t type, uint32_t value);
+void rdsparser_event_call(rdsparser_t *rds, rdsparser_event_type_t type, uint32_t value);
+
+static inline void
+rdsparser_event_emit(rdsparser_t            *rds,
+                     rdsparser_event_type_t  type,
+                     uint32_t                value)
+{
+    if (rds->events)
+    {
+        rdsparser_event_push(rds, type, value);
+    }
+
+    if (rds->callback_event)
+    {
+        rdsparser_event_call(rds, type, value);
+    }
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include <librdsparser_private.h>
 #include "rdsparser.h"
 #include "group.h"
+#include "group15.h"
 
 
 static inline uint16_t
@@ -26,6 +27,22 @@ rdsparser_group_get_pi(const rdsparser_data_t data)
     return data[RDSPARSER_BLOCK_A];
 }
 
+static inline uint16_t
+rdsparser_group_get_pi_c(const rdsparser_data_t data)
+{
+    return data[RDSPARSER_BLOCK_C];
+}
+
+static inline bool
+rdsparser_group_has_pi_c(const rdsparser_data_t  data,
+                         const rdsparser_error_t errors)
+{
+    /* Version B groups repeat the PI in block C', the version
+       bit of a corrected block B may be wrong and is not trusted */
+    return (errors[RDSPARSER_BLOCK_B] == RDSPARSER_BLOCK_ERROR_NONE &&
+            (data[RDSPARSER_BLOCK_B] & 0x0800));
+}
+
 static inline uint8_t
 rdsparser_group_get_pty(const rdsparser_data_t data)
 {
@@ -38,19 +55,128 @@ rdsparser_group_get_tp(const rdsparser_data_t data)
     return (data[RDSPARSER_BLOCK_B] & 0x400) >> 10;
 }
 
-void
+static inline bool
+rdsparser_group_check_pending(rdsparser_t *rds)
+{
+    if (rds->station_count == 0)
+    {
+        return true;
+    }
+
+    /* A group without a reliable PI can not be assigned to
+       either station while the new one is not confirmed yet */
+    rds->modified = true;
+    return false;
+}
+
+static bool
+rdsparser_group_check_station(rdsparser_t             *rds,
+                              const rdsparser_data_t   data,
+                              const rdsparser_error_t  errors)
+{
+    const rdsparser_pi_t current = rdsparser_get_pi(rds);
+    rdsparser_pi_t pi;
+
+    /* Only error-free copies are trusted here */
+    if (errors[RDSPARSER_BLOCK_A] == RDSPARSER_BLOCK_ERROR_NONE)
+    {
+        pi = rdsparser_group_get_pi(data);
+        if (errors[RDSPARSER_BLOCK_C] == RDSPARSER_BLOCK_ERROR_NONE &&
+            rdsparser_group_has_pi_c(data, errors) &&
+            pi != rdsparser_group_get_pi_c(data))
+        {
+            return rdsparser_group_check_pending(rds);
+        }
+    }
+    else if (errors[RDSPARSER_BLOCK_C] == RDSPARSER_BLOCK_ERROR_NONE &&
+             rdsparser_group_has_pi_c(data, errors))
+    {
+        pi = rdsparser_group_get_pi_c(data);
+    }
+    else
+    {
+        return rdsparser_group_check_pending(rds);
+    }
+
+    if (current == RDSPARSER_PI_UNKNOWN ||
+        pi == current)
+    {
+        if (rds->station_count)
+        {
+            rds->station_count = 0;
+            rds->modified = true;
+        }
+        return true;
+    }
+
+    if (pi != rds->station_pi)
+    {
+        rds->station_pi = pi;
+        rds->station_count = 0;
+    }
+
+    rds->modified = true;
+
+    /* Groups of a possible new station are dropped until it is confirmed */
+    if (++rds->station_count < rds->station_change)
+    {
+        return false;
+    }
+
+    rdsparser_set_station(rds, pi);
+    return true;
+}
+
+bool
 rdsparser_group_parse(rdsparser_t             *rds,
                       const rdsparser_data_t   data,
                       const rdsparser_error_t  errors)
 {
-    if (errors[RDSPARSER_BLOCK_A] == 0)
+    if (rds->station_change &&
+        (rds->features & RDSPARSER_FEATURE_PI) &&
+        !rdsparser_group_check_station(rds, data, errors))
+    {
+        return false;
+    }
+
+    if (rds->features & RDSPARSER_FEATURE_PI)
     {
-        rdsparser_set_pi(rds, rdsparser_group_get_pi(data));
+        const bool pi_a = (errors[RDSPARSER_BLOCK_A] != RDSPARSER_BLOCK_ERROR_UNCORRECTABLE);
+        const bool pi_c = (errors[RDSPARSER_BLOCK_C] != RDSPARSER_BLOCK_ERROR_UNCORRECTABLE && rdsparser_group_has_pi_c(data, errors));
+
+        /* Two copies in one group confirm each other (also in the extended
+           check), mismatching error-free ones are both ignored. Corrected
+           copies are only taken into account by the voting. */
+        if (errors[RDSPARSER_BLOCK_A] != RDSPARSER_BLOCK_ERROR_NONE ||
+            errors[RDSPARSER_BLOCK_C] != RDSPARSER_BLOCK_ERROR_NONE ||
+            !pi_c ||
+            rdsparser_group_get_pi(data) == rdsparser_group_get_pi_c(data))
+        {
+            if (pi_a)
+            {
+                rdsparser_set_pi(rds, rdsparser_group_get_pi(data), errors[RDSPARSER_BLOCK_A]);
+            }
+
+            if (pi_c)
+            {
+                rdsparser_set_pi(rds, rdsparser_group_get_pi_c(data), errors[RDSPARSER_BLOCK_C]);
+            }
+        }
     }
 
-    if (errors[RDSPARSER_BLOCK_B] == 0)
+    if (errors[RDSPARSER_BLOCK_B] != RDSPARSER_BLOCK_ERROR_UNCORRECTABLE &&
+        rdsparser_group15_check(data, errors))
     {
-        rdsparser_set_pty(rds, rdsparser_group_get_pty(data));
-        rdsparser_set_tp(rds, rdsparser_group_get_tp(data));
+        if (rds->features & RDSPARSER_FEATURE_PTY)
+        {
+            rdsparser_set_pty(rds, rdsparser_group_get_pty(data), errors[RDSPARSER_BLOCK_B]);
+        }
+
+        if (rds->features & RDSPARSER_FEATURE_TP)
+        {
+            rdsparser_set_tp(rds, rdsparser_group_get_tp(data), errors[RDSPARSER_BLOCK_B]);
+        }
     }
+
+    return true;
 }
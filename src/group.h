@@ -18,6 +18,6 @@
 #define RDSPARSER_GROUP_H
 #include <librdsparser_private.h>
 
-void rdsparser_group_parse(rdsparser_t *rds, const rdsparser_data_t data, const rdsparser_error_t errors);
+bool rdsparser_group_parse(rdsparser_t *rds, const rdsparser_data_t data, const rdsparser_error_t errors);
 
 #endif
\ No newline at end of file
@@ -16,6 +16,7 @@
 
 #include <librdsparser_private.h>
 #include "rdsparser.h"
+#include "event.h"
 #include "parser.h"
 #include "string.h"
 
@@ -78,29 +79,46 @@ rdsparser_group0_parse(rdsparser_t             *rds,
                        const rdsparser_error_t  errors,
                        rdsparser_group_flag_t   flag)
 {
-    if (errors[RDSPARSER_BLOCK_B] == 0)
+    if (errors[RDSPARSER_BLOCK_B] != RDSPARSER_BLOCK_ERROR_UNCORRECTABLE)
     {
-        rdsparser_set_ta(rds, rdsparser_group0_get_ta(data));
-        rdsparser_set_ms(rds, rdsparser_group0_get_ms(data));
+        if (rds->features & RDSPARSER_FEATURE_TA)
+        {
+            rdsparser_set_ta(rds, rdsparser_group0_get_ta(data), errors[RDSPARSER_BLOCK_B]);
+        }
+
+        if (rds->features & RDSPARSER_FEATURE_MS)
+        {
+            rdsparser_set_ms(rds, rdsparser_group0_get_ms(data), errors[RDSPARSER_BLOCK_B]);
+        }
     }
 
-    const uint8_t position = 2 * rdsparser_group0_get_ps_pos(data);
-    bool changed = rdsparser_parser_update_string(rds,
-                                                  rds->ps,
-                                                  RDSPARSER_TEXT_PS,
-                                                  RDSPARSER_BLOCK_D,
-                                                  data,
-                                                  errors,
-                                                  position);
-
-    if (changed &&
-        rds->callback_ps)
+    if (rds->features & RDSPARSER_FEATURE_PS)
     {
-        rds->callback_ps(rds,
-                         rds->user_data);
+        const uint8_t position = 2 * rdsparser_group0_get_ps_pos(data);
+        rdsparser_string_begin_update(rds->ps);
+        bool changed = rdsparser_parser_update_string(rds,
+                                                      rds->ps,
+                                                      RDSPARSER_TEXT_PS,
+                                                      RDSPARSER_BLOCK_D,
+                                                      data,
+                                                      errors,
+                                                      position);
+
+        if (changed)
+        {
+            rds->modified = true;
+            rds->changes |= RDSPARSER_CHANGE_PS;
+            rdsparser_event_emit(rds, RDSPARSER_EVENT_PS, 0);
+            if (rds->callback_ps)
+            {
+                rds->callback_ps(rds,
+                                 rds->user_data);
+            }
+        }
     }
 
-    if (flag == RDSPARSER_GROUP_FLAG_A)
+    if (flag == RDSPARSER_GROUP_FLAG_A &&
+        (rds->features & RDSPARSER_FEATURE_AF))
     {
         rdsparser_group0a_parse(rds, data, errors);
     }
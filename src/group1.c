@@ -35,14 +35,16 @@ rdsparser_group1a_parse(rdsparser_t             *rds,
                         const rdsparser_data_t   data,
                         const rdsparser_error_t  errors)
 {
-    if (errors[RDSPARSER_BLOCK_B] == 0 &&
-        errors[RDSPARSER_BLOCK_C] == 0)
+    if (errors[RDSPARSER_BLOCK_B] != RDSPARSER_BLOCK_ERROR_UNCORRECTABLE &&
+        errors[RDSPARSER_BLOCK_C] != RDSPARSER_BLOCK_ERROR_UNCORRECTABLE)
     {
         if (rdsparser_group1a_get_variant(data) == 0)
         {
+            /* The ECC is only as reliable as the worse of both blocks */
+            const rdsparser_block_error_t error = (errors[RDSPARSER_BLOCK_B] > errors[RDSPARSER_BLOCK_C]) ? errors[RDSPARSER_BLOCK_B] : errors[RDSPARSER_BLOCK_C];
             uint8_t ecc = rdsparser_group1a0_get_ecc(data);
-            rdsparser_set_ecc(rds, ecc);
-            rdsparser_set_country(rds, rdsparser_ecc_lookup(rdsparser_get_pi(rds), ecc));
+            rdsparser_set_ecc(rds, ecc, error);
+            rdsparser_set_country(rds, rdsparser_ecc_lookup(rdsparser_get_pi(rds), ecc), error);
         }
     }
 }
@@ -16,6 +16,7 @@
 
 #include <librdsparser_private.h>
 #include "rdsparser.h"
+#include "event.h"
 #include "parser.h"
 #include "string.h"
 
@@ -33,6 +34,7 @@ rdsparser_group10a_parse(rdsparser_t             *rds,
     uint8_t position = 4 * rdsparser_group10a_get_ptyn_pos(data);
 
     bool changed = false;
+    rdsparser_string_begin_update(rds->ptyn);
     changed |= rdsparser_parser_update_string(rds,
                                               rds->ptyn,
                                               RDSPARSER_TEXT_PTYN,
@@ -49,10 +51,15 @@ rdsparser_group10a_parse(rdsparser_t             *rds,
                                               errors,
                                               position + 2);
 
-    if (changed &&
-        rds->callback_ptyn)
+    if (changed)
     {
-        rds->callback_ptyn(rds, rds->user_data);
+        rds->modified = true;
+        rds->changes |= RDSPARSER_CHANGE_PTYN;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_PTYN, 0);
+        if (rds->callback_ptyn)
+        {
+            rds->callback_ptyn(rds, rds->user_data);
+        }
     }
 }
 
@@ -0,0 +1,123 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#include <librdsparser_private.h>
+#include "rdsparser.h"
+
+static inline bool
+rdsparser_group15b_get_ta(uint16_t block)
+{
+    return (block & 0x10) >> 4;
+}
+
+static inline bool
+rdsparser_group15b_get_ms(uint16_t block)
+{
+    return (block & 0x8) >> 3;
+}
+
+static inline uint8_t
+rdsparser_group15b_get_pty(uint16_t block)
+{
+    return (block & 0x03E0) >> 5;
+}
+
+static inline bool
+rdsparser_group15b_get_tp(uint16_t block)
+{
+    return (block & 0x400) >> 10;
+}
+
+static inline bool
+rdsparser_group15b_has_copy(const rdsparser_data_t  data,
+                            const rdsparser_error_t errors)
+{
+    /* Block D repeats the block B, including the group type */
+    return (errors[RDSPARSER_BLOCK_D] != RDSPARSER_BLOCK_ERROR_UNCORRECTABLE &&
+            (data[RDSPARSER_BLOCK_D] & 0xF800) == (data[RDSPARSER_BLOCK_B] & 0xF800));
+}
+
+static inline void
+rdsparser_group15b_set_flags(rdsparser_t             *rds,
+                             uint16_t                 block,
+                             rdsparser_block_error_t  error)
+{
+    if (rds->features & RDSPARSER_FEATURE_TA)
+    {
+        rdsparser_set_ta(rds, rdsparser_group15b_get_ta(block), error);
+    }
+
+    if (rds->features & RDSPARSER_FEATURE_MS)
+    {
+        rdsparser_set_ms(rds, rdsparser_group15b_get_ms(block), error);
+    }
+}
+
+bool
+rdsparser_group15_check(const rdsparser_data_t  data,
+                        const rdsparser_error_t errors)
+{
+    /* Mismatching error-free copies are both ignored, this is
+       checked before the PTY and TP are taken from the block B */
+    return !((data[RDSPARSER_BLOCK_B] & 0xF800) == 0xF800 &&
+             rdsparser_group15b_has_copy(data, errors) &&
+             errors[RDSPARSER_BLOCK_B] == RDSPARSER_BLOCK_ERROR_NONE &&
+             errors[RDSPARSER_BLOCK_D] == RDSPARSER_BLOCK_ERROR_NONE &&
+             data[RDSPARSER_BLOCK_B] != data[RDSPARSER_BLOCK_D]);
+}
+
+static inline void
+rdsparser_group15b_parse(rdsparser_t             *rds,
+                         const rdsparser_data_t   data,
+                         const rdsparser_error_t  errors)
+{
+    if (!rdsparser_group15_check(data, errors))
+    {
+        return;
+    }
+
+    const bool copy = rdsparser_group15b_has_copy(data, errors);
+    rdsparser_group15b_set_flags(rds, data[RDSPARSER_BLOCK_B], errors[RDSPARSER_BLOCK_B]);
+
+    if (copy)
+    {
+        /* PTY and TP from the block B are decoded for all groups, two
+           copies in one group confirm each other (also in the extended check) */
+        if (rds->features & RDSPARSER_FEATURE_PTY)
+        {
+            rdsparser_set_pty(rds, rdsparser_group15b_get_pty(data[RDSPARSER_BLOCK_D]), errors[RDSPARSER_BLOCK_D]);
+        }
+
+        if (rds->features & RDSPARSER_FEATURE_TP)
+        {
+            rdsparser_set_tp(rds, rdsparser_group15b_get_tp(data[RDSPARSER_BLOCK_D]), errors[RDSPARSER_BLOCK_D]);
+        }
+
+        rdsparser_group15b_set_flags(rds, data[RDSPARSER_BLOCK_D], errors[RDSPARSER_BLOCK_D]);
+    }
+}
+
+void
+rdsparser_group15_parse(rdsparser_t             *rds,
+                        const rdsparser_data_t   data,
+                        const rdsparser_error_t  errors,
+                        rdsparser_group_flag_t   flag)
+{
+    if (flag == RDSPARSER_GROUP_FLAG_B)
+    {
+        rdsparser_group15b_parse(rds, data, errors);
+    }
+}
@@ -0,0 +1,24 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#ifndef RDSPARSER_GROUP15_H
+#define RDSPARSER_GROUP15_H
+#include <librdsparser_private.h>
+
+bool rdsparser_group15_check(const rdsparser_data_t data, const rdsparser_error_t errors);
+void rdsparser_group15_parse(rdsparser_t *rds, const rdsparser_data_t data, const rdsparser_error_t errors, rdsparser_group_flag_t flag);
+
+#endif
\ No newline at end of file
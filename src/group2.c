@@ -16,6 +16,7 @@
 
 #include <librdsparser_private.h>
 #include "rdsparser.h"
+#include "event.h"
 #include "parser.h"
 #include "string.h"
 
@@ -40,6 +41,7 @@ rdsparser_group2_parse(rdsparser_t             *rds,
     rdsparser_rt_flag_t rt_flag = rdsparser_group2_get_rt_flag(data);
     bool changed = false;
 
+    rdsparser_string_begin_update(rds->rt[rt_flag]);
     if (errors[RDSPARSER_BLOCK_B] == 0 &&
         rt_flag != rds->last_rt_flag)
     {
@@ -51,6 +53,7 @@ rdsparser_group2_parse(rdsparser_t             *rds,
         }
 
         rds->last_rt_flag = rt_flag;
+        rds->modified = true;
     }
 
     if (errors[RDSPARSER_BLOCK_B] != 0 &&
@@ -88,11 +91,16 @@ rdsparser_group2_parse(rdsparser_t             *rds,
                                               errors,
                                               position);
 
-    if (changed &&
-        rds->callback_rt)
+    if (changed)
     {
-        rds->callback_rt(rds,
-                         rt_flag,
-                         rds->user_data);
+        rds->modified = true;
+        rds->changes |= (rdsparser_change_t)(RDSPARSER_CHANGE_RT_A << rt_flag);
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_RT, rt_flag);
+        if (rds->callback_rt)
+        {
+            rds->callback_rt(rds,
+                             rt_flag,
+                             rds->user_data);
+        }
     }
 }
@@ -16,6 +16,7 @@
 
 #include <librdsparser_private.h>
 #include "ct.h"
+#include "event.h"
 
 static inline uint32_t
 rdsparser_group4a_get_mjd(const rdsparser_data_t data)
@@ -66,10 +67,17 @@ rdsparser_group4a_parse(rdsparser_t             *rds,
         int8_t offset = rdsparser_group4a_get_time_offset(data);
 
         rdsparser_ct_t ct;
-        if (rds->callback_ct &&
-            rdsparser_ct_init(&ct, mjd, hour, minute, offset))
+        if (rdsparser_ct_init(&ct, mjd, hour, minute, offset))
         {
-            rds->callback_ct(rds, &ct, rds->user_data);
+            rds->ct = ct;
+            rds->ct_available = true;
+            rds->modified = true;
+            rds->changes |= RDSPARSER_CHANGE_CT;
+            rdsparser_event_emit(rds, RDSPARSER_EVENT_CT, 0);
+            if (rds->callback_ct)
+            {
+                rds->callback_ct(rds, &rds->ct, rds->user_data);
+            }
         }
     }
 }
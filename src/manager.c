@@ -0,0 +1,311 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdint.h>
+#include <librdsparser_private.h>
+#include "parser.h"
+
+/* Table entry: PI in [15:0], station index + 1 in [31:16], 0 if empty */
+#define RDSPARSER_MANAGER_EMPTY 0
+#define RDSPARSER_MANAGER_INDEX_SHIFT 16
+#define RDSPARSER_MANAGER_CAPACITY_MAX 0xFFFF
+
+static inline uint32_t
+rdsparser_manager_hash(const rdsparser_manager_t *manager,
+                       uint16_t                   pi)
+{
+    /* Fibonacci hashing, PI codes are far from uniform */
+    return ((uint32_t)pi * 0x9E3779B1UL >> 16) & manager->mask;
+}
+
+static inline uint32_t
+rdsparser_manager_entry(uint16_t pi,
+                        uint32_t index)
+{
+    return ((index + 1) << RDSPARSER_MANAGER_INDEX_SHIFT) | pi;
+}
+
+static inline uint32_t
+rdsparser_manager_entry_index(uint32_t entry)
+{
+    return (entry >> RDSPARSER_MANAGER_INDEX_SHIFT) - 1;
+}
+
+static inline uint16_t
+rdsparser_manager_entry_pi(uint32_t entry)
+{
+    return (uint16_t)(entry & 0xFFFF);
+}
+
+#ifndef RDSPARSER_DISABLE_HEAP
+rdsparser_manager_t*
+rdsparser_manager_new(uint32_t capacity)
+{
+    uint32_t table_size = 1;
+
+    if (capacity == 0 ||
+        capacity > RDSPARSER_MANAGER_CAPACITY_MAX)
+    {
+        return NULL;
+    }
+
+    /* Keep the load factor at most 50% */
+    while (table_size < capacity * 2)
+    {
+        table_size <<= 1;
+    }
+
+    rdsparser_manager_t *manager = malloc(sizeof(rdsparser_manager_t));
+    rdsparser_manager_station_t *stations = malloc(sizeof(rdsparser_manager_station_t) * capacity);
+    uint32_t *table = malloc(sizeof(uint32_t) * table_size);
+
+    if (manager == NULL ||
+        stations == NULL ||
+        table == NULL)
+    {
+        free(manager);
+        free(stations);
+        free(table);
+        return NULL;
+    }
+
+    rdsparser_manager_init(manager, stations, capacity, table, table_size);
+    return manager;
+}
+
+void
+rdsparser_manager_free(rdsparser_manager_t *manager)
+{
+    if (manager)
+    {
+        free(manager->stations);
+        free(manager->table);
+        free(manager);
+    }
+}
+#endif
+
+bool
+rdsparser_manager_init(rdsparser_manager_t         *manager,
+                       rdsparser_manager_station_t *stations,
+                       uint32_t                     capacity,
+                       uint32_t                    *table,
+                       uint32_t                     table_size)
+{
+    /* The table size must be a power of two larger than the capacity */
+    if (capacity == 0 ||
+        capacity > RDSPARSER_MANAGER_CAPACITY_MAX ||
+        table_size <= capacity ||
+        (table_size & (table_size - 1)))
+    {
+        return false;
+    }
+
+    manager->stations = stations;
+    manager->table = table;
+    manager->capacity = capacity;
+    manager->mask = table_size - 1;
+    manager->callback_new = NULL;
+    manager->user_data = NULL;
+    rdsparser_manager_clear(manager);
+    return true;
+}
+
+void
+rdsparser_manager_clear(rdsparser_manager_t *manager)
+{
+    for (uint32_t i = 0; i <= manager->mask; i++)
+    {
+        manager->table[i] = RDSPARSER_MANAGER_EMPTY;
+    }
+
+    manager->count = 0;
+    manager->last = NULL;
+}
+
+static uint32_t
+rdsparser_manager_lookup(const rdsparser_manager_t *manager,
+                         uint16_t                   pi)
+{
+    uint32_t slot = rdsparser_manager_hash(manager, pi);
+
+    while (manager->table[slot] != RDSPARSER_MANAGER_EMPTY &&
+           rdsparser_manager_entry_pi(manager->table[slot]) != pi)
+    {
+        slot = (slot + 1) & manager->mask;
+    }
+
+    return slot;
+}
+
+static rdsparser_t*
+rdsparser_manager_station(rdsparser_manager_t     *manager,
+                          uint16_t                 pi,
+                          rdsparser_block_error_t  error)
+{
+    const uint32_t slot = rdsparser_manager_lookup(manager, pi);
+
+    if (manager->table[slot] != RDSPARSER_MANAGER_EMPTY)
+    {
+        return &manager->stations[rdsparser_manager_entry_index(manager->table[slot])].rds;
+    }
+
+    if (error != RDSPARSER_BLOCK_ERROR_NONE)
+    {
+        /* A corrected PI may be miscorrected, stations are
+           created only from error-free ones */
+        return NULL;
+    }
+
+    if (manager->count == manager->capacity)
+    {
+        /* Pool exhausted */
+        return NULL;
+    }
+
+    const uint32_t index = manager->count++;
+    rdsparser_manager_station_t *station = &manager->stations[index];
+    manager->table[slot] = rdsparser_manager_entry(pi, index);
+    station->pi = pi;
+    rdsparser_init(&station->rds);
+
+    if (manager->callback_new)
+    {
+        manager->callback_new(&station->rds, pi, manager->user_data);
+    }
+
+    return &station->rds;
+}
+
+rdsparser_t*
+rdsparser_manager_parse(rdsparser_manager_t     *manager,
+                        const rdsparser_data_t   data,
+                        const rdsparser_error_t  errors)
+{
+    rdsparser_t *rds = manager->last;
+
+    if (errors[RDSPARSER_BLOCK_A] <= RDSPARSER_BLOCK_ERROR_SMALL)
+    {
+        rds = rdsparser_manager_station(manager, data[RDSPARSER_BLOCK_A], errors[RDSPARSER_BLOCK_A]);
+    }
+    else if (errors[RDSPARSER_BLOCK_B] == RDSPARSER_BLOCK_ERROR_NONE &&
+             (data[RDSPARSER_BLOCK_B] & 0x0800) &&
+             errors[RDSPARSER_BLOCK_C] <= RDSPARSER_BLOCK_ERROR_SMALL)
+    {
+        /* Version B groups carry the PI in block C' */
+        rds = rdsparser_manager_station(manager, data[RDSPARSER_BLOCK_C], errors[RDSPARSER_BLOCK_C]);
+    }
+
+    if (rds)
+    {
+        /* Groups without a reliable PI go to the last station */
+        manager->last = rds;
+        rdsparser_parser_process(rds, data, errors);
+    }
+
+    return rds;
+}
+
+rdsparser_t*
+rdsparser_manager_find(const rdsparser_manager_t *manager,
+                       uint16_t                   pi)
+{
+    const uint32_t entry = manager->table[rdsparser_manager_lookup(manager, pi)];
+
+    if (entry == RDSPARSER_MANAGER_EMPTY)
+    {
+        return NULL;
+    }
+
+    return &manager->stations[rdsparser_manager_entry_index(entry)].rds;
+}
+
+bool
+rdsparser_manager_remove(rdsparser_manager_t *manager,
+                         uint16_t             pi)
+{
+    uint32_t slot = rdsparser_manager_lookup(manager, pi);
+
+    if (manager->table[slot] == RDSPARSER_MANAGER_EMPTY)
+    {
+        return false;
+    }
+
+    const uint32_t index = rdsparser_manager_entry_index(manager->table[slot]);
+
+    /* Backward shift deletion keeps the probe sequences intact */
+    uint32_t next = (slot + 1) & manager->mask;
+    while (manager->table[next] != RDSPARSER_MANAGER_EMPTY)
+    {
+        const uint32_t home = rdsparser_manager_hash(manager, rdsparser_manager_entry_pi(manager->table[next]));
+        if (((next - home) & manager->mask) >= ((next - slot) & manager->mask))
+        {
+            manager->table[slot] = manager->table[next];
+            slot = next;
+        }
+        next = (next + 1) & manager->mask;
+    }
+    manager->table[slot] = RDSPARSER_MANAGER_EMPTY;
+
+    if (manager->last == &manager->stations[index].rds)
+    {
+        manager->last = NULL;
+    }
+
+    /* Keep the stations dense, move the last one into the gap */
+    const uint32_t last = --manager->count;
+    if (index != last)
+    {
+        rdsparser_manager_station_t *moved = &manager->stations[last];
+        manager->stations[index] = *moved;
+        manager->table[rdsparser_manager_lookup(manager, moved->pi)] = rdsparser_manager_entry(moved->pi, index);
+
+        if (manager->last == &moved->rds)
+        {
+            manager->last = &manager->stations[index].rds;
+        }
+    }
+
+    return true;
+}
+
+uint32_t
+rdsparser_manager_get_count(const rdsparser_manager_t *manager)
+{
+    return manager->count;
+}
+
+rdsparser_t*
+rdsparser_manager_get(const rdsparser_manager_t *manager,
+                      uint32_t                   index)
+{
+    return (index < manager->count) ? &manager->stations[index].rds : NULL;
+}
+
+void
+rdsparser_manager_set_user_data(rdsparser_manager_t *manager,
+                                void                *user_data)
+{
+    manager->user_data = user_data;
+}
+
+void
+rdsparser_manager_register_new(rdsparser_manager_t  *manager,
+                               void                (*callback_new)(rdsparser_t*, uint16_t, void*))
+{
+    manager->callback_new = callback_new;
+}
@@ -15,6 +15,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 #include <librdsparser_private.h>
 #include "af.h"
 #include "group.h"
@@ -23,6 +24,8 @@
 #include "group2.h"
 #include "group4.h"
 #include "group10.h"
+#include "group15.h"
+#include "parser.h"
 #include "string.h"
 
 static inline uint8_t
@@ -37,36 +40,280 @@ rdsparser_parser_get_flag(const rdsparser_data_t data)
     return (data[RDSPARSER_BLOCK_B] & 0x0800) >> 11;
 }
 
+static inline uint8_t
+rdsparser_parser_classify(const rdsparser_data_t  data,
+                          const rdsparser_error_t errors)
+{
+    if (errors[RDSPARSER_BLOCK_B] == RDSPARSER_BLOCK_ERROR_UNCORRECTABLE)
+    {
+        /* Group type is unknown */
+        return RDSPARSER_PARSER_GROUP_UNKNOWN;
+    }
+
+    return (uint8_t)((rdsparser_parser_get_group(data) << 1) | rdsparser_parser_get_flag(data));
+}
+
+static void
+rdsparser_parser_group0a(rdsparser_t             *rds,
+                         const rdsparser_data_t   data,
+                         const rdsparser_error_t  errors,
+                         void                    *user_data)
+{
+    rdsparser_group0_parse(rds, data, errors, RDSPARSER_GROUP_FLAG_A);
+}
+
+static void
+rdsparser_parser_group0b(rdsparser_t             *rds,
+                         const rdsparser_data_t   data,
+                         const rdsparser_error_t  errors,
+                         void                    *user_data)
+{
+    rdsparser_group0_parse(rds, data, errors, RDSPARSER_GROUP_FLAG_B);
+}
+
+static void
+rdsparser_parser_group1a(rdsparser_t             *rds,
+                         const rdsparser_data_t   data,
+                         const rdsparser_error_t  errors,
+                         void                    *user_data)
+{
+    rdsparser_group1_parse(rds, data, errors, RDSPARSER_GROUP_FLAG_A);
+}
+
+static void
+rdsparser_parser_group2a(rdsparser_t             *rds,
+                         const rdsparser_data_t   data,
+                         const rdsparser_error_t  errors,
+                         void                    *user_data)
+{
+    rdsparser_group2_parse(rds, data, errors, RDSPARSER_GROUP_FLAG_A);
+}
+
+static void
+rdsparser_parser_group2b(rdsparser_t             *rds,
+                         const rdsparser_data_t   data,
+                         const rdsparser_error_t  errors,
+                         void                    *user_data)
+{
+    rdsparser_group2_parse(rds, data, errors, RDSPARSER_GROUP_FLAG_B);
+}
+
+static void
+rdsparser_parser_group4a(rdsparser_t             *rds,
+                         const rdsparser_data_t   data,
+                         const rdsparser_error_t  errors,
+                         void                    *user_data)
+{
+    rdsparser_group4_parse(rds, data, errors, RDSPARSER_GROUP_FLAG_A);
+}
+
+static void
+rdsparser_parser_group10a(rdsparser_t             *rds,
+                          const rdsparser_data_t   data,
+                          const rdsparser_error_t  errors,
+                          void                    *user_data)
+{
+    rdsparser_group10_parse(rds, data, errors, RDSPARSER_GROUP_FLAG_A);
+}
+
+static void
+rdsparser_parser_group15b(rdsparser_t             *rds,
+                          const rdsparser_data_t   data,
+                          const rdsparser_error_t  errors,
+                          void                    *user_data)
+{
+    rdsparser_group15_parse(rds, data, errors, RDSPARSER_GROUP_FLAG_B);
+}
+
+/* Built-in decoders, these slots can not be overridden */
+static const rdsparser_group_handler_t rdsparser_parser_builtin[RDSPARSER_GROUP_TYPE_COUNT] =
+{
+    [(0 << 1) | RDSPARSER_GROUP_FLAG_A] = rdsparser_parser_group0a,
+    [(0 << 1) | RDSPARSER_GROUP_FLAG_B] = rdsparser_parser_group0b,
+    [(1 << 1) | RDSPARSER_GROUP_FLAG_A] = rdsparser_parser_group1a,
+    [(2 << 1) | RDSPARSER_GROUP_FLAG_A] = rdsparser_parser_group2a,
+    [(2 << 1) | RDSPARSER_GROUP_FLAG_B] = rdsparser_parser_group2b,
+    [(4 << 1) | RDSPARSER_GROUP_FLAG_A] = rdsparser_parser_group4a,
+    [(10 << 1) | RDSPARSER_GROUP_FLAG_A] = rdsparser_parser_group10a,
+    [(15 << 1) | RDSPARSER_GROUP_FLAG_B] = rdsparser_parser_group15b
+};
+
+/* Features provided by the built-in decoders, a group type
+   is skipped at dispatch when none of them is enabled */
+static const rdsparser_feature_t rdsparser_parser_features[RDSPARSER_GROUP_TYPE_COUNT] =
+{
+    [(0 << 1) | RDSPARSER_GROUP_FLAG_A] = RDSPARSER_FEATURE_TA | RDSPARSER_FEATURE_MS | RDSPARSER_FEATURE_PS | RDSPARSER_FEATURE_AF,
+    [(0 << 1) | RDSPARSER_GROUP_FLAG_B] = RDSPARSER_FEATURE_TA | RDSPARSER_FEATURE_MS | RDSPARSER_FEATURE_PS,
+    [(1 << 1) | RDSPARSER_GROUP_FLAG_A] = RDSPARSER_FEATURE_ECC,
+    [(2 << 1) | RDSPARSER_GROUP_FLAG_A] = RDSPARSER_FEATURE_RT,
+    [(2 << 1) | RDSPARSER_GROUP_FLAG_B] = RDSPARSER_FEATURE_RT,
+    [(4 << 1) | RDSPARSER_GROUP_FLAG_A] = RDSPARSER_FEATURE_CT,
+    [(10 << 1) | RDSPARSER_GROUP_FLAG_A] = RDSPARSER_FEATURE_PTYN,
+    [(15 << 1) | RDSPARSER_GROUP_FLAG_B] = RDSPARSER_FEATURE_PTY | RDSPARSER_FEATURE_TP | RDSPARSER_FEATURE_TA | RDSPARSER_FEATURE_MS
+};
+
+void
+rdsparser_parser_init(rdsparser_t *rds)
+{
+    for (uint8_t type = 0; type < RDSPARSER_GROUP_TYPE_COUNT; type++)
+    {
+        rds->handler[type] = NULL;
+    }
+
+    rdsparser_parser_update(rds);
+}
+
+void
+rdsparser_parser_update(rdsparser_t *rds)
+{
+    rdsparser_parser_flush(rds);
+    for (uint8_t type = 0; type < RDSPARSER_GROUP_TYPE_COUNT; type++)
+    {
+        if (rdsparser_parser_builtin[type])
+        {
+            rds->handler[type] = ((rdsparser_parser_features[type] & rds->features) ? rdsparser_parser_builtin[type] : NULL);
+        }
+    }
+}
+
+bool
+rdsparser_parser_set_handler(rdsparser_t               *rds,
+                             uint8_t                    type,
+                             rdsparser_group_handler_t  handler)
+{
+    if (type >= RDSPARSER_GROUP_TYPE_COUNT ||
+        rdsparser_parser_builtin[type])
+    {
+        return false;
+    }
+
+    rds->handler[type] = handler;
+    rdsparser_parser_flush(rds);
+    return true;
+}
+
+void
+rdsparser_parser_flush(rdsparser_t *rds)
+{
+    rds->repeat.valid = 0;
+}
+
+static inline void
+rdsparser_parser_decode(rdsparser_t             *rds,
+                        const rdsparser_data_t   data,
+                        const rdsparser_error_t  errors,
+                        uint8_t                  type)
+{
+    if (!rdsparser_group_parse(rds, data, errors))
+    {
+        return;
+    }
+
+    /* Built-in and custom decoders share a single indexed load,
+       unhandled and unknown group types a single not-taken branch */
+    if (type < RDSPARSER_GROUP_TYPE_COUNT &&
+        rds->handler[type])
+    {
+        rds->handler[type](rds, data, errors, rds->user_data);
+    }
+}
+
+static inline void
+rdsparser_parser_dispatch(rdsparser_t             *rds,
+                          const rdsparser_data_t   data,
+                          const rdsparser_error_t  errors,
+                          uint8_t                  type)
+{
+    rdsparser_repeat_cache_t *cache = &rds->repeat;
+    const uint64_t group = ((uint64_t)data[RDSPARSER_BLOCK_A] << 48) |
+                           ((uint64_t)data[RDSPARSER_BLOCK_B] << 32) |
+                           ((uint64_t)data[RDSPARSER_BLOCK_C] << 16) |
+                           (uint64_t)data[RDSPARSER_BLOCK_D];
+    const uint8_t error = (uint8_t)((errors[RDSPARSER_BLOCK_A] << 6) |
+                                    (errors[RDSPARSER_BLOCK_B] << 4) |
+                                    (errors[RDSPARSER_BLOCK_C] << 2) |
+                                    errors[RDSPARSER_BLOCK_D]);
+    /* Two-way set associative, the newest entry goes first */
+    const uint32_t hash = ((uint32_t)group ^ (uint32_t)(group >> 32) ^ error) * 0x9E3779B9UL;
+    const uint8_t set = (uint8_t)(hash >> (32 - RDSPARSER_REPEAT_CACHE_BITS + 1)) << 1;
+
+    cache->lookups++;
+    for (uint8_t index = set; index < set + 2; index++)
+    {
+        if (((cache->valid >> index) & 1) &&
+            cache->group[index] == group &&
+            cache->errors[index] == error)
+        {
+            /* The same group did not change anything last time,
+               and nothing was changed since then */
+            cache->hits++;
+            return;
+        }
+    }
+
+    rds->modified = false;
+    rds->buffer.modified = false;
+    rdsparser_parser_decode(rds, data, errors, type);
+
+    if (rds->modified || rds->buffer.modified)
+    {
+        rdsparser_parser_flush(rds);
+    }
+    else if (type >= RDSPARSER_GROUP_TYPE_COUNT ||
+             rdsparser_parser_builtin[type] ||
+             rds->handler[type] == NULL)
+    {
+        /* Groups for custom handlers are always passed to them */
+        cache->group[set + 1] = cache->group[set];
+        cache->errors[set + 1] = cache->errors[set];
+        cache->valid |= (uint16_t)((cache->valid & (1U << set)) << 1);
+
+        cache->group[set] = group;
+        cache->errors[set] = error;
+        cache->valid |= (uint16_t)(1U << set);
+    }
+}
+
 void
 rdsparser_parser_process(rdsparser_t             *rds,
                          const rdsparser_data_t   data,
                          const rdsparser_error_t  errors)
 {
-    rdsparser_group_parse(rds, data, errors);
+    rdsparser_parser_dispatch(rds, data, errors, rdsparser_parser_classify(data, errors));
+}
 
-    rdsparser_group_flag_t flag = rdsparser_parser_get_flag(data);
-    uint8_t group = rdsparser_parser_get_group(data);
-    switch (group)
-    {
-        case 0:
-            rdsparser_group0_parse(rds, data, errors, flag);
-            break;
+void
+rdsparser_parser_process_batch(rdsparser_t             *rds,
+                               const rdsparser_data_t  *data,
+                               const rdsparser_error_t *errors,
+                               size_t                   count)
+{
+    static const rdsparser_error_t no_errors = { 0 };
+    uint8_t types[RDSPARSER_PARSER_BATCH_CHUNK];
 
-        case 1:
-            rdsparser_group1_parse(rds, data, errors, flag);
-            break;
+    while (count)
+    {
+        const size_t chunk = (count < RDSPARSER_PARSER_BATCH_CHUNK ? count : RDSPARSER_PARSER_BATCH_CHUNK);
 
-        case 2:
-            rdsparser_group2_parse(rds, data, errors, flag);
-            break;
+        /* First pass: classify the whole chunk */
+        for (size_t i = 0; i < chunk; i++)
+        {
+            types[i] = rdsparser_parser_classify(data[i], errors ? errors[i] : no_errors);
+        }
 
-        case 4:
-            rdsparser_group4_parse(rds, data, errors, flag);
-            break;
+        /* Second pass: decode in the original order. The settings and
+           handlers are not cached, as a callback may change them */
+        for (size_t i = 0; i < chunk; i++)
+        {
+            rdsparser_parser_dispatch(rds, data[i], errors ? errors[i] : no_errors, types[i]);
+        }
 
-        case 10:
-            rdsparser_group10_parse(rds, data, errors, flag);
-            break;
+        data += chunk;
+        if (errors)
+        {
+            errors += chunk;
+        }
+        count -= chunk;
     }
 }
 
@@ -86,13 +333,17 @@ rdsparser_parser_update_string(rdsparser_t             *context,
         block[0] = data[data_block] >> 8;
         block[1] = (uint8_t)data[data_block];
 
-        return rdsparser_string_update(string,
-                                       block,
-                                       errors[RDSPARSER_BLOCK_B],
-                                       errors[data_block],
-                                       position,
-                                       context->progressive[text],
-                                       true);
+        if (rdsparser_string_update(string,
+                                    block,
+                                    errors[RDSPARSER_BLOCK_B],
+                                    errors[data_block],
+                                    position,
+                                    context->progressive[text],
+                                    true))
+        {
+            rdsparser_string_update_utf8(string);
+            return true;
+        }
     }
 
     return false;
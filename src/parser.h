@@ -16,9 +16,18 @@
 
 #ifndef RDSPARSER_PARSER_H
 #define RDSPARSER_PARSER_H
+#include <stddef.h>
 #include <librdsparser_private.h>
 
+#define RDSPARSER_PARSER_BATCH_CHUNK 64
+#define RDSPARSER_PARSER_GROUP_UNKNOWN 0xFF
+
+void rdsparser_parser_init(rdsparser_t *rds);
+void rdsparser_parser_update(rdsparser_t *rds);
+void rdsparser_parser_flush(rdsparser_t *rds);
+bool rdsparser_parser_set_handler(rdsparser_t *rds, uint8_t type, rdsparser_group_handler_t handler);
 void rdsparser_parser_process(rdsparser_t *rds, const rdsparser_data_t data, const rdsparser_error_t errors);
+void rdsparser_parser_process_batch(rdsparser_t *rds, const rdsparser_data_t *data, const rdsparser_error_t *errors, size_t count);
 bool rdsparser_parser_update_string(rdsparser_t *rds, rdsparser_string_t *string, rdsparser_text_t text, rdsparser_block_t data_block, const rdsparser_data_t data, const rdsparser_error_t errors, uint8_t position);
 
 #endif
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include <librdsparser_private.h>
 #include "buffer.h"
 #include "af.h"
+#include "event.h"
 #include "parser.h"
 #include "utils.h"
 #include "string.h"
@@ -55,6 +56,8 @@ rdsparser_init(rdsparser_t *rds)
     rdsparser_string_init(rds->rt[0], RDSPARSER_RT_LENGTH);
     rdsparser_string_init(rds->rt[1], RDSPARSER_RT_LENGTH);
     rdsparser_string_init(rds->ptyn, RDSPARSER_PTYN_LENGTH);
+    rds->features = RDSPARSER_FEATURE_ALL;
+    rdsparser_parser_init(rds);
     rdsparser_clear(rds);
 }
 
@@ -66,22 +69,39 @@ rdsparser_clear(rdsparser_t *rds)
     rdsparser_string_clear(rds->rt[0]);
     rdsparser_string_clear(rds->rt[1]);
     rdsparser_string_clear(rds->ptyn);
+    rds->ct_available = false;
     rds->last_rt_flag = -1;
+    rds->station_pi = RDSPARSER_PI_UNKNOWN;
+    rds->station_count = 0;
+    rdsparser_parser_flush(rds);
 }
 
 void
-rdsparser_parse(rdsparser_t       *rds,
-                rdsparser_data_t   data,
-                rdsparser_error_t  errors)
+rdsparser_parse(rdsparser_t             *rds,
+                const rdsparser_data_t   data,
+                const rdsparser_error_t  errors)
 {
     rdsparser_parser_process(rds, data, errors);
 }
 
+void
+rdsparser_parse_batch(rdsparser_t             *rds,
+                      const rdsparser_data_t  *data,
+                      const rdsparser_error_t *errors,
+                      size_t                   count)
+{
+    if (data)
+    {
+        rdsparser_parser_process_batch(rds, data, errors, count);
+    }
+}
+
 void
 rdsparser_set_extended_check(rdsparser_t *rds,
                              bool         value)
 {
     rdsparser_buffer_set_extended_check(&rds->buffer, value);
+    rdsparser_parser_flush(rds);
 }
 
 bool
@@ -90,6 +110,118 @@ rdsparser_get_extended_check(const rdsparser_t *rds)
     return rdsparser_buffer_get_extended_check(&rds->buffer);
 }
 
+static uint8_t
+rdsparser_get_voting_field(rdsparser_feature_t field)
+{
+    uint8_t index = 0;
+    while (!(field & 1))
+    {
+        field >>= 1;
+        index++;
+    }
+    return index;
+}
+
+void
+rdsparser_set_station_change(rdsparser_t *rds,
+                             uint8_t      groups)
+{
+    rds->station_change = groups;
+    rds->station_pi = RDSPARSER_PI_UNKNOWN;
+    rds->station_count = 0;
+    rdsparser_parser_flush(rds);
+}
+
+uint8_t
+rdsparser_get_station_change(const rdsparser_t *rds)
+{
+    return rds->station_change;
+}
+
+uint64_t
+rdsparser_get_repeat_lookups(const rdsparser_t *rds)
+{
+    return rds->repeat.lookups;
+}
+
+uint64_t
+rdsparser_get_repeat_hits(const rdsparser_t *rds)
+{
+    return rds->repeat.hits;
+}
+
+bool
+rdsparser_set_voting(rdsparser_t         *rds,
+                     rdsparser_feature_t  fields,
+                     uint8_t              threshold,
+                     uint8_t              window)
+{
+    if (fields == 0 ||
+        (fields & ~RDSPARSER_VOTING_FEATURES) ||
+        (threshold && (window == 0 || window > RDSPARSER_VOTING_WINDOW_MAX)) ||
+        threshold > 3 * window)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < RDSPARSER_BUFFER_FIELD_COUNTRY; i++)
+    {
+        if (fields & (1 << i))
+        {
+            rdsparser_buffer_set_voting(&rds->buffer, (rdsparser_buffer_field_t)i, threshold, window);
+        }
+    }
+
+    if (fields & RDSPARSER_FEATURE_ECC)
+    {
+        /* The country is derived from the ECC */
+        rdsparser_buffer_set_voting(&rds->buffer, RDSPARSER_BUFFER_FIELD_COUNTRY, threshold, window);
+    }
+
+    rdsparser_parser_flush(rds);
+    return true;
+}
+
+uint8_t
+rdsparser_get_voting_threshold(const rdsparser_t   *rds,
+                               rdsparser_feature_t  field)
+{
+    if (field == 0 ||
+        (field & ~RDSPARSER_VOTING_FEATURES))
+    {
+        return 0;
+    }
+
+    return rdsparser_buffer_get_voting_threshold(&rds->buffer, (rdsparser_buffer_field_t)rdsparser_get_voting_field(field));
+}
+
+uint8_t
+rdsparser_get_voting_window(const rdsparser_t   *rds,
+                            rdsparser_feature_t  field)
+{
+    if (field == 0 ||
+        (field & ~RDSPARSER_VOTING_FEATURES))
+    {
+        return 0;
+    }
+
+    return rdsparser_buffer_get_voting_window(&rds->buffer, (rdsparser_buffer_field_t)rdsparser_get_voting_field(field));
+}
+
+void
+rdsparser_set_feature_mask(rdsparser_t         *rds,
+                           rdsparser_feature_t  mask)
+{
+    rds->features = mask & RDSPARSER_FEATURE_ALL;
+    rdsparser_parser_update(rds);
+}
+
+rdsparser_feature_t
+rdsparser_get_feature_mask(const rdsparser_t *rds)
+{
+    return rds->features;
+}
+
 bool
 rdsparser_parse_string(rdsparser_t *rds,
                        const char  *input)
@@ -107,6 +239,34 @@ rdsparser_parse_string(rdsparser_t *rds,
     return false;
 }
 
+size_t
+rdsparser_convert_strings(const char *const *input,
+                          size_t             count,
+                          rdsparser_data_t  *data,
+                          rdsparser_error_t *errors)
+{
+    size_t converted = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (input[i] &&
+            rdsparser_utils_convert(input[i], data[i], errors[i]))
+        {
+            converted++;
+            continue;
+        }
+
+        /* Keep the arrays aligned with the input, the parser ignores such groups */
+        for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+        {
+            data[i][block] = 0;
+            errors[i][block] = RDSPARSER_BLOCK_ERROR_UNCORRECTABLE;
+        }
+    }
+
+    return converted;
+}
+
 void
 rdsparser_set_text_correction(rdsparser_t             *rds,
                               rdsparser_text_t         text,
@@ -115,6 +275,7 @@ rdsparser_set_text_correction(rdsparser_t             *rds,
 {
     const rdsparser_block_error_t max_error = RDSPARSER_BLOCK_ERROR_UNCORRECTABLE - 1;
     rds->correction[text][type] = (error < max_error ? error : max_error);
+    rdsparser_parser_flush(rds);
 }
 
 rdsparser_block_error_t
@@ -131,6 +292,7 @@ rdsparser_set_text_progressive(rdsparser_t      *rds,
                                bool              state)
 {
     rds->progressive[text] = state;
+    rdsparser_parser_flush(rds);
 }
 
 bool
@@ -140,12 +302,152 @@ rdsparser_get_text_progressive(const rdsparser_t *rds,
     return rds->progressive[text];
 }
 
+static void
+rdsparser_station_notify(rdsparser_t *rds)
+{
+    /* Every reset field is reported, so that nothing from the previous
+       station is displayed anymore. The AF callback receives 0 and the
+       CT callback NULL, as there is no frequency or clock time left */
+    const rdsparser_feature_t features = rds->features;
+
+    rds->changes |= RDSPARSER_CHANGE_PI;
+    rdsparser_event_emit(rds, RDSPARSER_EVENT_PI, (uint32_t)rdsparser_get_pi(rds));
+    if (rds->callback_pi)
+    {
+        rds->callback_pi(rds, rds->user_data);
+    }
+
+    if (features & RDSPARSER_FEATURE_PTY)
+    {
+        rds->changes |= RDSPARSER_CHANGE_PTY;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_PTY, (uint32_t)rdsparser_get_pty(rds));
+        if (rds->callback_pty)
+        {
+            rds->callback_pty(rds, rds->user_data);
+        }
+    }
+
+    if (features & RDSPARSER_FEATURE_TP)
+    {
+        rds->changes |= RDSPARSER_CHANGE_TP;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_TP, (uint32_t)rdsparser_get_tp(rds));
+        if (rds->callback_tp)
+        {
+            rds->callback_tp(rds, rds->user_data);
+        }
+    }
+
+    if (features & RDSPARSER_FEATURE_TA)
+    {
+        rds->changes |= RDSPARSER_CHANGE_TA;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_TA, (uint32_t)rdsparser_get_ta(rds));
+        if (rds->callback_ta)
+        {
+            rds->callback_ta(rds, rds->user_data);
+        }
+    }
+
+    if (features & RDSPARSER_FEATURE_MS)
+    {
+        rds->changes |= RDSPARSER_CHANGE_MS;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_MS, (uint32_t)rdsparser_get_ms(rds));
+        if (rds->callback_ms)
+        {
+            rds->callback_ms(rds, rds->user_data);
+        }
+    }
+
+    if (features & RDSPARSER_FEATURE_ECC)
+    {
+        rds->changes |= RDSPARSER_CHANGE_ECC | RDSPARSER_CHANGE_COUNTRY;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_ECC, (uint32_t)rdsparser_get_ecc(rds));
+        if (rds->callback_ecc)
+        {
+            rds->callback_ecc(rds, rds->user_data);
+        }
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_COUNTRY, (uint32_t)rdsparser_get_country(rds));
+        if (rds->callback_country)
+        {
+            rds->callback_country(rds, rds->user_data);
+        }
+    }
+
+    if (features & RDSPARSER_FEATURE_AF)
+    {
+        rds->changes |= RDSPARSER_CHANGE_AF;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_AF, 0);
+        if (rds->callback_af)
+        {
+            rds->callback_af(rds, 0, rds->user_data);
+        }
+    }
+
+    if (features & RDSPARSER_FEATURE_PS)
+    {
+        rds->changes |= RDSPARSER_CHANGE_PS;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_PS, 0);
+        if (rds->callback_ps)
+        {
+            rds->callback_ps(rds, rds->user_data);
+        }
+    }
+
+    if (features & RDSPARSER_FEATURE_RT)
+    {
+        for (uint8_t flag = RDSPARSER_RT_FLAG_A; flag <= RDSPARSER_RT_FLAG_B; flag++)
+        {
+            rds->changes |= (rdsparser_change_t)(RDSPARSER_CHANGE_RT_A << flag);
+            rdsparser_event_emit(rds, RDSPARSER_EVENT_RT, flag);
+            if (rds->callback_rt)
+            {
+                rds->callback_rt(rds, (rdsparser_rt_flag_t)flag, rds->user_data);
+            }
+        }
+    }
+
+    if (features & RDSPARSER_FEATURE_PTYN)
+    {
+        rds->changes |= RDSPARSER_CHANGE_PTYN;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_PTYN, 0);
+        if (rds->callback_ptyn)
+        {
+            rds->callback_ptyn(rds, rds->user_data);
+        }
+    }
+
+    if (features & RDSPARSER_FEATURE_CT)
+    {
+        rds->changes |= RDSPARSER_CHANGE_CT;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_CT, 0);
+        if (rds->callback_ct)
+        {
+            rds->callback_ct(rds, NULL, rds->user_data);
+        }
+    }
+}
+
+void
+rdsparser_set_station(rdsparser_t    *rds,
+                      rdsparser_pi_t  pi)
+{
+    const rdsparser_ct_t no_ct = { 0 };
+
+    /* Nothing from the previous station is kept */
+    rdsparser_clear(rds);
+    rds->ct = no_ct;
+    rdsparser_buffer_confirm_pi(&rds->buffer, pi);
+    rdsparser_station_notify(rds);
+}
+
 void
-rdsparser_set_pi(rdsparser_t    *rds,
-                 rdsparser_pi_t  pi)
+rdsparser_set_pi(rdsparser_t             *rds,
+                 rdsparser_pi_t           pi,
+                 rdsparser_block_error_t  error)
 {
-    if (rdsparser_buffer_update_pi(&rds->buffer, pi))
+    if (rdsparser_buffer_update_pi(&rds->buffer, pi, error))
     {
+        rds->changes |= RDSPARSER_CHANGE_PI;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_PI, (uint32_t)pi);
         if (rds->callback_pi)
         {
             rds->callback_pi(rds, rds->user_data);
@@ -160,11 +462,14 @@ rdsparser_get_pi(const rdsparser_t *rds)
 }
 
 void
-rdsparser_set_pty(rdsparser_t     *rds,
-                  rdsparser_pty_t  pty)
+rdsparser_set_pty(rdsparser_t             *rds,
+                  rdsparser_pty_t          pty,
+                  rdsparser_block_error_t  error)
 {
-    if (rdsparser_buffer_update_pty(&rds->buffer, pty))
+    if (rdsparser_buffer_update_pty(&rds->buffer, pty, error))
     {
+        rds->changes |= RDSPARSER_CHANGE_PTY;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_PTY, (uint32_t)pty);
         if (rds->callback_pty)
         {
             rds->callback_pty(rds, rds->user_data);
@@ -179,11 +484,14 @@ rdsparser_get_pty(const rdsparser_t *rds)
 }
 
 void
-rdsparser_set_tp(rdsparser_t    *rds,
-                 rdsparser_tp_t  tp)
+rdsparser_set_tp(rdsparser_t             *rds,
+                 rdsparser_tp_t           tp,
+                 rdsparser_block_error_t  error)
 {
-    if (rdsparser_buffer_update_tp(&rds->buffer, tp))
+    if (rdsparser_buffer_update_tp(&rds->buffer, tp, error))
     {
+        rds->changes |= RDSPARSER_CHANGE_TP;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_TP, (uint32_t)tp);
         if (rds->callback_tp)
         {
             rds->callback_tp(rds, rds->user_data);
@@ -198,11 +506,14 @@ rdsparser_get_tp(const rdsparser_t *rds)
 }
 
 void
-rdsparser_set_ta(rdsparser_t     *rds,
-                  rdsparser_ta_t  ta)
+rdsparser_set_ta(rdsparser_t             *rds,
+                 rdsparser_ta_t           ta,
+                 rdsparser_block_error_t  error)
 {
-    if (rdsparser_buffer_update_ta(&rds->buffer, ta))
+    if (rdsparser_buffer_update_ta(&rds->buffer, ta, error))
     {
+        rds->changes |= RDSPARSER_CHANGE_TA;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_TA, (uint32_t)ta);
         if (rds->callback_ta)
         {
             rds->callback_ta(rds, rds->user_data);
@@ -217,11 +528,14 @@ rdsparser_get_ta(const rdsparser_t *rds)
 }
 
 void
-rdsparser_set_ms(rdsparser_t    *rds,
-                 rdsparser_ms_t  ms)
+rdsparser_set_ms(rdsparser_t             *rds,
+                 rdsparser_ms_t           ms,
+                 rdsparser_block_error_t  error)
 {
-    if (rdsparser_buffer_update_ms(&rds->buffer, ms))
+    if (rdsparser_buffer_update_ms(&rds->buffer, ms, error))
     {
+        rds->changes |= RDSPARSER_CHANGE_MS;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_MS, (uint32_t)ms);
         if (rds->callback_ms)
         {
             rds->callback_ms(rds, rds->user_data);
@@ -236,11 +550,14 @@ rdsparser_get_ms(const rdsparser_t *rds)
 }
 
 void
-rdsparser_set_ecc(rdsparser_t     *rds,
-                  rdsparser_ecc_t  ecc)
+rdsparser_set_ecc(rdsparser_t             *rds,
+                  rdsparser_ecc_t          ecc,
+                  rdsparser_block_error_t  error)
 {
-    if (rdsparser_buffer_update_ecc(&rds->buffer, ecc))
+    if (rdsparser_buffer_update_ecc(&rds->buffer, ecc, error))
     {
+        rds->changes |= RDSPARSER_CHANGE_ECC;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_ECC, (uint32_t)ecc);
         if (rds->callback_ecc)
         {
             rds->callback_ecc(rds, rds->user_data);
@@ -255,11 +572,14 @@ rdsparser_get_ecc(const rdsparser_t *rds)
 }
 
 void
-rdsparser_set_country(rdsparser_t         *rds,
-                      rdsparser_country_t  country)
+rdsparser_set_country(rdsparser_t             *rds,
+                      rdsparser_country_t      country,
+                      rdsparser_block_error_t  error)
 {
-    if (rdsparser_buffer_update_country(&rds->buffer, country))
+    if (rdsparser_buffer_update_country(&rds->buffer, country, error))
     {
+        rds->changes |= RDSPARSER_CHANGE_COUNTRY;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_COUNTRY, (uint32_t)country);
         if (rds->callback_country)
         {
             rds->callback_country(rds, rds->user_data);
@@ -279,9 +599,11 @@ rdsparser_add_af(rdsparser_t *rds,
 {
     if (rdsparser_buffer_add_af(&rds->buffer, new_af))
     {
+        const uint32_t frequency = 87500 + (uint32_t)new_af * 100;
+        rds->changes |= RDSPARSER_CHANGE_AF;
+        rdsparser_event_emit(rds, RDSPARSER_EVENT_AF, frequency);
         if (rds->callback_af)
         {
-            const uint32_t frequency = 87500 + (uint32_t)new_af * 100;
             rds->callback_af(rds, frequency, rds->user_data);
         }
     }
@@ -312,6 +634,20 @@ rdsparser_get_ptyn(const rdsparser_t *rds)
     return rds->ptyn;
 }
 
+const rdsparser_ct_t*
+rdsparser_get_ct(const rdsparser_t *rds)
+{
+    return (rds->ct_available ? &rds->ct : NULL);
+}
+
+rdsparser_change_t
+rdsparser_poll_changes(rdsparser_t *rds)
+{
+    const rdsparser_change_t changes = rds->changes;
+    rds->changes = 0;
+    return changes;
+}
+
 void
 rdsparser_set_user_data(rdsparser_t *rds,
                         void        *user_data)
@@ -402,3 +738,25 @@ rdsparser_register_ct(rdsparser_t  *rds,
 {
     rds->callback_ct = callback_ct;
 }
+
+void
+rdsparser_register_event(rdsparser_t  *rds,
+                         void        (*callback_event)(rdsparser_t*, rdsparser_event_type_t, const rdsparser_event_payload_t*, void*))
+{
+    rds->callback_event = callback_event;
+}
+
+bool
+rdsparser_register_group(rdsparser_t                *rds,
+                         uint8_t                     group,
+                         rdsparser_group_version_t   version,
+                         void                      (*handler)(rdsparser_t*, const rdsparser_data_t, const rdsparser_error_t, void*))
+{
+    if (group > 15 ||
+        version > RDSPARSER_GROUP_VERSION_B)
+    {
+        return false;
+    }
+
+    return rdsparser_parser_set_handler(rds, (uint8_t)((group << 1) | version), handler);
+}
@@ -17,13 +17,14 @@
 #ifndef RDSPARSER_RDSPARSER_H
 #define RDSPARSER_RDSPARSER_H
 
-void rdsparser_set_pi(rdsparser_t *rds, rdsparser_pi_t pi);
-void rdsparser_set_pty(rdsparser_t *rds, rdsparser_pty_t pty);
-void rdsparser_set_tp(rdsparser_t *rds, rdsparser_tp_t tp);
-void rdsparser_set_ta(rdsparser_t *rds, rdsparser_ta_t ta);
-void rdsparser_set_ms(rdsparser_t *rds, rdsparser_ms_t ms);
-void rdsparser_set_ecc(rdsparser_t *rds, rdsparser_ecc_t ecc);
-void rdsparser_set_country(rdsparser_t *rds, rdsparser_country_t country);
+void rdsparser_set_station(rdsparser_t *rds, rdsparser_pi_t pi);
+void rdsparser_set_pi(rdsparser_t *rds, rdsparser_pi_t pi, rdsparser_block_error_t error);
+void rdsparser_set_pty(rdsparser_t *rds, rdsparser_pty_t pty, rdsparser_block_error_t error);
+void rdsparser_set_tp(rdsparser_t *rds, rdsparser_tp_t tp, rdsparser_block_error_t error);
+void rdsparser_set_ta(rdsparser_t *rds, rdsparser_ta_t ta, rdsparser_block_error_t error);
+void rdsparser_set_ms(rdsparser_t *rds, rdsparser_ms_t ms, rdsparser_block_error_t error);
+void rdsparser_set_ecc(rdsparser_t *rds, rdsparser_ecc_t ecc, rdsparser_block_error_t error);
+void rdsparser_set_country(rdsparser_t *rds, rdsparser_country_t country, rdsparser_block_error_t error);
 void rdsparser_add_af(rdsparser_t *rds, uint8_t new_af);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,250 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif !defined(RDSPARSER_DISABLE_THREADS)
+#include <sched.h>
+#endif
+#include <stdint.h>
+#include <librdsparser_private.h>
+#include "atomic.h"
+#include "parser.h"
+
+/* Records dequeued at once by rdsparser_ring_parse */
+#define RDSPARSER_RING_CHUNK 32
+
+static void
+rdsparser_ring_wait(void)
+{
+#if defined(_WIN32)
+    SwitchToThread();
+#elif !defined(RDSPARSER_DISABLE_THREADS)
+    sched_yield();
+#endif
+}
+
+#ifndef RDSPARSER_DISABLE_HEAP
+rdsparser_ring_t*
+rdsparser_ring_new(uint32_t                capacity,
+                   rdsparser_ring_policy_t policy)
+{
+    rdsparser_ring_t *ring = malloc(sizeof(rdsparser_ring_t));
+    rdsparser_ring_record_t *records = malloc(sizeof(rdsparser_ring_record_t) * capacity);
+
+    if (ring == NULL ||
+        records == NULL ||
+        !rdsparser_ring_init(ring, records, capacity, policy))
+    {
+        free(ring);
+        free(records);
+        return NULL;
+    }
+
+    return ring;
+}
+
+void
+rdsparser_ring_free(rdsparser_ring_t *ring)
+{
+    if (ring)
+    {
+        free(ring->records);
+        free(ring);
+    }
+}
+#endif
+
+bool
+rdsparser_ring_init(rdsparser_ring_t        *ring,
+                    rdsparser_ring_record_t *records,
+                    uint32_t                 capacity,
+                    rdsparser_ring_policy_t  policy)
+{
+    /* The capacity must be a power of two */
+    if (records == NULL ||
+        capacity == 0 ||
+        (capacity & (capacity - 1)) ||
+        policy > RDSPARSER_RING_POLICY_BLOCK)
+    {
+        return false;
+    }
+
+    ring->records = records;
+    ring->mask = capacity - 1;
+    ring->policy = policy;
+    atomic_init(rdsparser_atomic(&ring->head), 0);
+    atomic_init(rdsparser_atomic(&ring->tail), 0);
+    atomic_init(rdsparser_atomic(&ring->dropped), 0);
+    return true;
+}
+
+bool
+rdsparser_ring_push(rdsparser_ring_t        *ring,
+                    const rdsparser_data_t   data,
+                    const rdsparser_error_t  errors)
+{
+    const uint32_t tail = atomic_load_explicit(rdsparser_atomic(&ring->tail), memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(rdsparser_atomic(&ring->head), memory_order_acquire);
+    bool stored = true;
+
+    while (tail - head > ring->mask)
+    {
+        if (ring->policy == RDSPARSER_RING_POLICY_DROP_NEWEST)
+        {
+            atomic_fetch_add_explicit(rdsparser_atomic(&ring->dropped), 1, memory_order_relaxed);
+            return false;
+        }
+
+        if (ring->policy == RDSPARSER_RING_POLICY_DROP_OLDEST)
+        {
+            /* A failed exchange means the consumer has just made room */
+            if (atomic_compare_exchange_strong_explicit(rdsparser_atomic(&ring->head), &head, head + 1,
+                                                        memory_order_acq_rel,
+                                                        memory_order_acquire))
+            {
+                atomic_fetch_add_explicit(rdsparser_atomic(&ring->dropped), 1, memory_order_relaxed);
+                stored = false;
+            }
+            break;
+        }
+
+        /* Block: wait for the consumer */
+        rdsparser_ring_wait();
+        head = atomic_load_explicit(rdsparser_atomic(&ring->head), memory_order_acquire);
+    }
+
+    /* With the oldest records dropped, the consumer may be reading
+       this one at the same time, so it is only accessed atomically */
+    rdsparser_ring_record_t *record = &ring->records[tail & ring->mask];
+    for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+    {
+        rdsparser_atomic_store16(&record->data[block], data[block]);
+        rdsparser_atomic_store8(&record->errors[block], errors[block]);
+    }
+
+    atomic_store_explicit(rdsparser_atomic(&ring->tail), tail + 1, memory_order_release);
+    return stored;
+}
+
+static uint32_t
+rdsparser_ring_take(rdsparser_ring_t        *ring,
+                    rdsparser_ring_record_t *output,
+                    uint32_t                 max)
+{
+    uint32_t head = atomic_load_explicit(rdsparser_atomic(&ring->head), memory_order_acquire);
+
+    while (true)
+    {
+        const uint32_t tail = atomic_load_explicit(rdsparser_atomic(&ring->tail), memory_order_acquire);
+        uint32_t count = tail - head;
+
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        if (count > max)
+        {
+            count = max;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const rdsparser_ring_record_t *record = &ring->records[(head + i) & ring->mask];
+            for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+            {
+                output[i].data[block] = rdsparser_atomic_load16(&record->data[block]);
+                output[i].errors[block] = rdsparser_atomic_load8(&record->errors[block]);
+            }
+        }
+
+        /* The copy is only valid if the producer has not dropped
+           (and overwritten) any of the records in the meantime,
+           otherwise it is retried (lock-free, but not wait-free) */
+        if (atomic_compare_exchange_strong_explicit(rdsparser_atomic(&ring->head), &head, head + count,
+                                                    memory_order_acq_rel,
+                                                    memory_order_acquire))
+        {
+            return count;
+        }
+    }
+}
+
+bool
+rdsparser_ring_pop(rdsparser_ring_t  *ring,
+                   rdsparser_data_t   data,
+                   rdsparser_error_t  errors)
+{
+    rdsparser_ring_record_t record;
+
+    if (rdsparser_ring_take(ring, &record, 1) == 0)
+    {
+        return false;
+    }
+
+    for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+    {
+        data[block] = record.data[block];
+        errors[block] = record.errors[block];
+    }
+
+    return true;
+}
+
+size_t
+rdsparser_ring_parse(rdsparser_ring_t *ring,
+                     rdsparser_t      *rds,
+                     size_t            max)
+{
+    rdsparser_ring_record_t records[RDSPARSER_RING_CHUNK];
+    size_t parsed = 0;
+
+    while (parsed < max)
+    {
+        const size_t left = max - parsed;
+        const uint32_t count = rdsparser_ring_take(ring, records, (left < RDSPARSER_RING_CHUNK) ? (uint32_t)left : RDSPARSER_RING_CHUNK);
+
+        if (count == 0)
+        {
+            break;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            rdsparser_parser_process(rds, records[i].data, records[i].errors);
+        }
+
+        parsed += count;
+    }
+
+    return parsed;
+}
+
+uint32_t
+rdsparser_ring_get_count(const rdsparser_ring_t *ring)
+{
+    const uint32_t head = atomic_load_explicit(rdsparser_atomic(&ring->head), memory_order_acquire);
+    const uint32_t tail = atomic_load_explicit(rdsparser_atomic(&ring->tail), memory_order_acquire);
+    return tail - head;
+}
+
+uint32_t
+rdsparser_ring_get_dropped(const rdsparser_ring_t *ring)
+{
+    return atomic_load_explicit(rdsparser_atomic(&ring->dropped), memory_order_relaxed);
+}
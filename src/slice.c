@@ -0,0 +1,357 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdint.h>
+#include <librdsparser_private.h>
+#include "sync.h"
+
+/* Bit-sliced block synchronizer: bit n of each word belongs to lane n,
+ * so every bitwise operation advances all lanes at once. The syndrome
+ * of the 26-bit window is updated incrementally for each received bit.
+ * Lanes are handled one by one only when an offset word is detected
+ * during search or at the block boundary of a synchronized lane. */
+
+/* g(x) without the x^10 term */
+#define RDSPARSER_SLICE_POLY 0x1B9
+/* Remainder of x^26 modulo g(x), removes the bit leaving the window */
+#define RDSPARSER_SLICE_OUT 0x0EE
+
+static const uint16_t rdsparser_slice_offsets[RDSPARSER_SYNC_COUNT] =
+{
+    RDSPARSER_SYNC_OFFSET_A,
+    RDSPARSER_SYNC_OFFSET_B,
+    RDSPARSER_SYNC_OFFSET_C,
+    RDSPARSER_SYNC_OFFSET_CP,
+    RDSPARSER_SYNC_OFFSET_D
+};
+
+static inline uint8_t
+rdsparser_slice_lowest(uint64_t value)
+{
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_ctzll(value);
+#else
+    uint8_t lane = 0;
+    while (!(value & 1))
+    {
+        value >>= 1;
+        lane++;
+    }
+    return lane;
+#endif
+}
+
+/* Transpose of the 8x8 bit matrix stored in bytes (Hacker's Delight, 7-3) */
+static inline uint64_t
+rdsparser_slice_transpose(uint64_t x)
+{
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+#ifndef RDSPARSER_DISABLE_HEAP
+rdsparser_slice_t*
+rdsparser_slice_new(void)
+{
+    rdsparser_slice_t *slice = malloc(sizeof(rdsparser_slice_t));
+    if (slice)
+    {
+        rdsparser_slice_init(slice);
+    }
+
+    return slice;
+}
+
+void
+rdsparser_slice_free(rdsparser_slice_t *slice)
+{
+    if (slice)
+    {
+        free(slice);
+    }
+}
+#endif
+
+void
+rdsparser_slice_init(rdsparser_slice_t *slice)
+{
+    slice->active = 0;
+    for (uint8_t lane = 0; lane < RDSPARSER_SLICE_LANES; lane++)
+    {
+        slice->lanes[lane].rds = NULL;
+    }
+
+    rdsparser_slice_reset(slice);
+}
+
+void
+rdsparser_slice_reset(rdsparser_slice_t *slice)
+{
+    for (uint8_t i = 0; i < RDSPARSER_SYNC_BLOCK_BITS; i++)
+    {
+        slice->history[i] = 0;
+        slice->history[i + RDSPARSER_SYNC_BLOCK_BITS] = 0;
+        slice->phase_mask[i] = 0;
+    }
+
+    for (uint8_t j = 0; j < RDSPARSER_SYNC_CHECK_BITS; j++)
+    {
+        slice->syndrome[j] = 0;
+    }
+
+    slice->synced = 0;
+    slice->position = 0;
+    slice->head = 0;
+    slice->phase = 0;
+    slice->fill = 0;
+
+    for (uint8_t lane = 0; lane < RDSPARSER_SLICE_LANES; lane++)
+    {
+        rdsparser_sync_reset(&slice->lanes[lane]);
+    }
+}
+
+void
+rdsparser_slice_attach(rdsparser_slice_t *slice,
+                       uint8_t            lane,
+                       rdsparser_t       *rds)
+{
+    if (lane >= RDSPARSER_SLICE_LANES)
+    {
+        return;
+    }
+
+    const uint64_t bit = 1ULL << lane;
+    rdsparser_sync_init(&slice->lanes[lane], rds);
+    slice->synced &= ~bit;
+
+    for (uint8_t phase = 0; phase < RDSPARSER_SYNC_BLOCK_BITS; phase++)
+    {
+        slice->phase_mask[phase] &= ~bit;
+    }
+
+    if (rds)
+    {
+        slice->active |= bit;
+    }
+    else
+    {
+        slice->active &= ~bit;
+    }
+}
+
+static uint32_t
+rdsparser_slice_gather(const rdsparser_slice_t *slice,
+                       uint8_t                  lane)
+{
+    const uint64_t *history = slice->history + slice->head;
+    uint32_t reg = 0;
+
+    /* The oldest bit is at the head */
+    for (uint8_t i = 0; i < RDSPARSER_SYNC_BLOCK_BITS; i++)
+    {
+        reg = (reg << 1) | (uint32_t)((history[i] >> lane) & 1);
+    }
+
+    return reg;
+}
+
+static size_t
+rdsparser_slice_boundary(rdsparser_slice_t *slice,
+                         uint64_t           lanes,
+                         uint8_t            phase)
+{
+    size_t groups = 0;
+
+    while (lanes)
+    {
+        const uint8_t lane = rdsparser_slice_lowest(lanes);
+        rdsparser_sync_t *sync = &slice->lanes[lane];
+        lanes &= lanes - 1;
+
+        sync->reg = rdsparser_slice_gather(slice, lane);
+        groups += rdsparser_sync_block(sync);
+
+        if (!sync->synced)
+        {
+            slice->synced &= ~(1ULL << lane);
+            slice->phase_mask[phase] &= ~(1ULL << lane);
+        }
+    }
+
+    return groups;
+}
+
+static void
+rdsparser_slice_search(rdsparser_slice_t *slice,
+                       uint64_t           lanes,
+                       uint8_t            phase)
+{
+    uint64_t match[RDSPARSER_SYNC_COUNT];
+    uint64_t any = 0;
+
+    for (uint8_t offset = 0; offset < RDSPARSER_SYNC_COUNT; offset++)
+    {
+        uint64_t mask = lanes;
+        for (uint8_t j = 0; j < RDSPARSER_SYNC_CHECK_BITS; j++)
+        {
+            mask &= ((rdsparser_slice_offsets[offset] >> j) & 1) ? slice->syndrome[j] : ~slice->syndrome[j];
+        }
+        match[offset] = mask;
+        any |= mask;
+    }
+
+    while (any)
+    {
+        const uint8_t lane = rdsparser_slice_lowest(any);
+        const uint64_t bit = 1ULL << lane;
+        rdsparser_sync_t *sync = &slice->lanes[lane];
+        uint8_t offset = 0;
+        any &= any - 1;
+
+        while (!(match[offset] & bit))
+        {
+            offset++;
+        }
+
+        sync->reg = rdsparser_slice_gather(slice, lane);
+        if (rdsparser_sync_detect(sync, offset, phase, slice->position))
+        {
+            slice->synced |= bit;
+            slice->phase_mask[phase] |= bit;
+        }
+    }
+}
+
+static inline size_t
+rdsparser_slice_bit(rdsparser_slice_t *slice,
+                    uint64_t           input)
+{
+    const uint8_t phase = slice->phase;
+    const uint64_t output = slice->history[slice->head];
+    uint64_t *syndrome = slice->syndrome;
+
+    slice->history[slice->head] = input;
+    slice->history[slice->head + RDSPARSER_SYNC_BLOCK_BITS] = input;
+    slice->head = (uint8_t)((slice->head + 1 == RDSPARSER_SYNC_BLOCK_BITS) ? 0 : slice->head + 1);
+    slice->phase = (uint8_t)((phase + 1 == RDSPARSER_SYNC_BLOCK_BITS) ? 0 : phase + 1);
+    slice->position++;
+
+    /* s(x) = s(x) * x + input - output * x^26 (mod g(x)) */
+    const uint64_t carry = syndrome[RDSPARSER_SYNC_CHECK_BITS - 1];
+    for (uint8_t j = RDSPARSER_SYNC_CHECK_BITS - 1; j > 0; j--)
+    {
+        syndrome[j] = syndrome[j - 1] ^
+                      (((RDSPARSER_SLICE_POLY >> j) & 1) ? carry : 0) ^
+                      (((RDSPARSER_SLICE_OUT >> j) & 1) ? output : 0);
+    }
+    syndrome[0] = input ^
+                  ((RDSPARSER_SLICE_POLY & 1) ? carry : 0) ^
+                  ((RDSPARSER_SLICE_OUT & 1) ? output : 0);
+
+    if (slice->fill < RDSPARSER_SYNC_BLOCK_BITS)
+    {
+        if (++slice->fill < RDSPARSER_SYNC_BLOCK_BITS)
+        {
+            return 0;
+        }
+    }
+
+    /* Lanes losing synchronization start searching from the next bit */
+    const uint64_t searching = slice->active & ~slice->synced;
+    const size_t groups = rdsparser_slice_boundary(slice, slice->phase_mask[phase], phase);
+
+    if (searching)
+    {
+        rdsparser_slice_search(slice, searching, phase);
+    }
+
+    return groups;
+}
+
+size_t
+rdsparser_slice_feed(rdsparser_slice_t *slice,
+                     const uint64_t    *bits,
+                     size_t             count)
+{
+    size_t groups = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        groups += rdsparser_slice_bit(slice, bits[i]);
+    }
+
+    return groups;
+}
+
+size_t
+rdsparser_slice_feed_lanes(rdsparser_slice_t    *slice,
+                           const uint8_t *const *buffers,
+                           size_t                bits)
+{
+    size_t groups = 0;
+
+    for (size_t position = 0; position < bits; position += 8)
+    {
+        const uint8_t count = (uint8_t)((bits - position < 8) ? bits - position : 8);
+        uint64_t words[8] = { 0 };
+
+        for (uint8_t group = 0; group < RDSPARSER_SLICE_LANES / 8; group++)
+        {
+            /* Row n of the 8x8 bit matrix is the byte of lane n */
+            uint64_t matrix = 0;
+            for (uint8_t row = 0; row < 8; row++)
+            {
+                const uint8_t lane = (uint8_t)(group * 8 + row);
+                if ((slice->active >> lane) & 1 &&
+                    buffers[lane])
+                {
+                    matrix |= (uint64_t)buffers[lane][position / 8] << (row * 8);
+                }
+            }
+
+            if (matrix == 0)
+            {
+                continue;
+            }
+
+            matrix = rdsparser_slice_transpose(matrix);
+            for (uint8_t i = 0; i < count; i++)
+            {
+                /* Bits are stored MSB first */
+                words[i] |= ((matrix >> ((7 - i) * 8)) & 0xFF) << (group * 8);
+            }
+        }
+
+        groups += rdsparser_slice_feed(slice, words, count);
+    }
+
+    return groups;
+}
+
+const rdsparser_sync_t*
+rdsparser_slice_get_lane(const rdsparser_slice_t *slice,
+                         uint8_t                  lane)
+{
+    return (lane < RDSPARSER_SLICE_LANES) ? &slice->lanes[lane] : NULL;
+}
@@ -0,0 +1,304 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#include <stdint.h>
+#include <librdsparser_private.h>
+#include "parser.h"
+#include "buffer.h"
+#include "string.h"
+
+#define RDSPARSER_SNAPSHOT_VERSION 2
+#define RDSPARSER_SNAPSHOT_HEADER_SIZE 8
+
+/* Header: "RDSS" magic, version, three reserved bytes.
+ * Body: little-endian fields in a fixed order (see rdsparser_snapshot_walk),
+ * string characters are always stored as 32-bit code points. */
+static const uint8_t rdsparser_snapshot_magic[4] = { 'R', 'D', 'S', 'S' };
+
+#define RDSPARSER_SNAPSHOT_BUFFER_DATA_SIZE (4 + 1 + 1 + 1 + 1 + 2 + 1 + RDSPARSER_AF_BUFFER_SIZE)
+#define RDSPARSER_SNAPSHOT_SETTINGS_SIZE (1 + 2 + RDSPARSER_TEXT_COUNT + RDSPARSER_TEXT_COUNT * RDSPARSER_BLOCK_TYPE_COUNT + 1 + 2 * RDSPARSER_BUFFER_FIELD_COUNT + 1)
+#define RDSPARSER_SNAPSHOT_CT_SIZE (1 + 2 + 1 + 1 + 1 + 1 + 1)
+#define RDSPARSER_SNAPSHOT_STRING_SIZE(len) (1 + (len) * (4 + 1))
+#define RDSPARSER_SNAPSHOT_SIZE (RDSPARSER_SNAPSHOT_HEADER_SIZE + \
+                                 2 * RDSPARSER_SNAPSHOT_BUFFER_DATA_SIZE + \
+                                 RDSPARSER_SNAPSHOT_SETTINGS_SIZE + \
+                                 RDSPARSER_SNAPSHOT_CT_SIZE + \
+                                 RDSPARSER_SNAPSHOT_STRING_SIZE(RDSPARSER_PS_LENGTH) + \
+                                 RDSPARSER_RT_FLAG_COUNT * RDSPARSER_SNAPSHOT_STRING_SIZE(RDSPARSER_RT_LENGTH) + \
+                                 RDSPARSER_SNAPSHOT_STRING_SIZE(RDSPARSER_PTYN_LENGTH))
+
+/* The same walk is used in both directions, so the
+   layout can not differ between save and load */
+typedef struct rdsparser_snapshot_cursor
+{
+    uint8_t *position;
+    bool load;
+} rdsparser_snapshot_cursor_t;
+
+static void
+rdsparser_snapshot_u8(rdsparser_snapshot_cursor_t *cursor,
+                      void                        *value)
+{
+    if (cursor->load)
+    {
+        *(uint8_t*)value = cursor->position[0];
+    }
+    else
+    {
+        cursor->position[0] = *(uint8_t*)value;
+    }
+
+    cursor->position += 1;
+}
+
+static void
+rdsparser_snapshot_u16(rdsparser_snapshot_cursor_t *cursor,
+                       void                        *value)
+{
+    if (cursor->load)
+    {
+        *(uint16_t*)value = (uint16_t)(cursor->position[0] | (cursor->position[1] << 8));
+    }
+    else
+    {
+        const uint16_t input = *(uint16_t*)value;
+        cursor->position[0] = (uint8_t)input;
+        cursor->position[1] = (uint8_t)(input >> 8);
+    }
+
+    cursor->position += 2;
+}
+
+static void
+rdsparser_snapshot_u32(rdsparser_snapshot_cursor_t *cursor,
+                       uint32_t                    *value)
+{
+    if (cursor->load)
+    {
+        *value = (uint32_t)cursor->position[0] |
+                 ((uint32_t)cursor->position[1] << 8) |
+                 ((uint32_t)cursor->position[2] << 16) |
+                 ((uint32_t)cursor->position[3] << 24);
+    }
+    else
+    {
+        cursor->position[0] = (uint8_t)*value;
+        cursor->position[1] = (uint8_t)(*value >> 8);
+        cursor->position[2] = (uint8_t)(*value >> 16);
+        cursor->position[3] = (uint8_t)(*value >> 24);
+    }
+
+    cursor->position += 4;
+}
+
+static void
+rdsparser_snapshot_bool(rdsparser_snapshot_cursor_t *cursor,
+                        bool                        *value)
+{
+    uint8_t byte = *value;
+    rdsparser_snapshot_u8(cursor, &byte);
+    if (cursor->load)
+    {
+        *value = (byte != 0);
+    }
+}
+
+static void
+rdsparser_snapshot_buffer_data(rdsparser_snapshot_cursor_t *cursor,
+                               rdsparser_buffer_data_t     *data)
+{
+    uint32_t pi = (uint32_t)data->pi;
+    rdsparser_snapshot_u32(cursor, &pi);
+    if (cursor->load)
+    {
+        data->pi = (rdsparser_pi_t)pi;
+    }
+
+    rdsparser_snapshot_u8(cursor, &data->pty);
+    rdsparser_snapshot_u8(cursor, &data->tp);
+    rdsparser_snapshot_u8(cursor, &data->ta);
+    rdsparser_snapshot_u8(cursor, &data->ms);
+    rdsparser_snapshot_u16(cursor, &data->ecc);
+    rdsparser_snapshot_u8(cursor, &data->country);
+
+    for (uint8_t i = 0; i < RDSPARSER_AF_BUFFER_SIZE; i++)
+    {
+        rdsparser_snapshot_u8(cursor, &data->af.buffer[i]);
+    }
+}
+
+static void
+rdsparser_snapshot_string(rdsparser_snapshot_cursor_t *cursor,
+                          rdsparser_string_t          *string,
+                          uint8_t                      length)
+{
+    rdsparser_string_char_t *content = (rdsparser_string_char_t*)rdsparser_string_get_content(string);
+    rdsparser_string_error_t *errors = (rdsparser_string_error_t*)rdsparser_string_get_errors(string);
+    rdsparser_string_table_t table = rdsparser_string_get_table(string);
+
+    rdsparser_snapshot_u8(cursor, &table);
+    if (cursor->load)
+    {
+        rdsparser_string_set_table(string, (table < RDSPARSER_STRING_TABLE_COUNT ? table : RDSPARSER_STRING_TABLE_G0));
+    }
+
+    for (uint8_t i = 0; i < length; i++)
+    {
+        uint32_t character = rdsparser_string_decode(string, content[i]);
+        rdsparser_snapshot_u32(cursor, &character);
+        if (cursor->load)
+        {
+            content[i] = rdsparser_string_encode(string, character);
+        }
+    }
+
+    for (uint8_t i = 0; i < length; i++)
+    {
+        rdsparser_snapshot_u8(cursor, &errors[i]);
+    }
+
+    if (cursor->load)
+    {
+        rdsparser_string_refresh(string);
+    }
+}
+
+static void
+rdsparser_snapshot_walk(rdsparser_snapshot_cursor_t *cursor,
+                        rdsparser_t                 *rds)
+{
+    rdsparser_snapshot_buffer_data(cursor, &rds->buffer.data_used);
+    rdsparser_snapshot_buffer_data(cursor, &rds->buffer.data_temp);
+
+    rdsparser_snapshot_bool(cursor, &rds->buffer.extended_check);
+    rdsparser_snapshot_u16(cursor, &rds->features);
+    for (uint8_t text = 0; text < RDSPARSER_TEXT_COUNT; text++)
+    {
+        rdsparser_snapshot_bool(cursor, &rds->progressive[text]);
+    }
+    for (uint8_t text = 0; text < RDSPARSER_TEXT_COUNT; text++)
+    {
+        for (uint8_t type = 0; type < RDSPARSER_BLOCK_TYPE_COUNT; type++)
+        {
+            rdsparser_snapshot_u8(cursor, &rds->correction[text][type]);
+        }
+    }
+    rdsparser_snapshot_u8(cursor, &rds->last_rt_flag);
+    for (uint8_t field = 0; field < RDSPARSER_BUFFER_FIELD_COUNT; field++)
+    {
+        /* Only the settings are stored, the voting history starts over */
+        rdsparser_vote_t *vote = &rds->buffer.vote[field];
+        rdsparser_snapshot_u8(cursor, &vote->threshold);
+        rdsparser_snapshot_u8(cursor, &vote->window);
+        if (cursor->load)
+        {
+            if (vote->window == 0 ||
+                vote->window > RDSPARSER_VOTING_WINDOW_MAX ||
+                vote->threshold > 3 * vote->window)
+            {
+                vote->threshold = 0;
+            }
+            rdsparser_buffer_set_voting(&rds->buffer, (rdsparser_buffer_field_t)field, vote->threshold, vote->window);
+        }
+    }
+    rdsparser_snapshot_u8(cursor, &rds->station_change);
+
+    rdsparser_snapshot_bool(cursor, &rds->ct_available);
+    rdsparser_snapshot_u16(cursor, &rds->ct.year);
+    rdsparser_snapshot_u8(cursor, &rds->ct.month);
+    rdsparser_snapshot_u8(cursor, &rds->ct.day);
+    rdsparser_snapshot_u8(cursor, &rds->ct.hour);
+    rdsparser_snapshot_u8(cursor, &rds->ct.minute);
+    rdsparser_snapshot_u8(cursor, &rds->ct.offset);
+
+    rdsparser_snapshot_string(cursor, rds->ps, RDSPARSER_PS_LENGTH);
+    for (uint8_t flag = 0; flag < RDSPARSER_RT_FLAG_COUNT; flag++)
+    {
+        rdsparser_snapshot_string(cursor, rds->rt[flag], RDSPARSER_RT_LENGTH);
+    }
+    rdsparser_snapshot_string(cursor, rds->ptyn, RDSPARSER_PTYN_LENGTH);
+}
+
+size_t
+rdsparser_snapshot_size(void)
+{
+    return RDSPARSER_SNAPSHOT_SIZE;
+}
+
+size_t
+rdsparser_snapshot_save(const rdsparser_t *rds,
+                        uint8_t           *buffer,
+                        size_t             size)
+{
+    if (size < RDSPARSER_SNAPSHOT_SIZE)
+    {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < sizeof(rdsparser_snapshot_magic); i++)
+    {
+        buffer[i] = rdsparser_snapshot_magic[i];
+    }
+
+    buffer[4] = RDSPARSER_SNAPSHOT_VERSION;
+    buffer[5] = 0;
+    buffer[6] = 0;
+    buffer[7] = 0;
+
+    /* Saving does not modify the context */
+    rdsparser_snapshot_cursor_t cursor = { buffer + RDSPARSER_SNAPSHOT_HEADER_SIZE, false };
+    rdsparser_snapshot_walk(&cursor, (rdsparser_t*)rds);
+    return RDSPARSER_SNAPSHOT_SIZE;
+}
+
+bool
+rdsparser_snapshot_load(rdsparser_t   *rds,
+                        const uint8_t *buffer,
+                        size_t         size)
+{
+    if (size < RDSPARSER_SNAPSHOT_SIZE)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < sizeof(rdsparser_snapshot_magic); i++)
+    {
+        if (buffer[i] != rdsparser_snapshot_magic[i])
+        {
+            return false;
+        }
+    }
+
+    if (buffer[4] != RDSPARSER_SNAPSHOT_VERSION)
+    {
+        return false;
+    }
+
+    /* Loading does not modify the buffer */
+    rdsparser_snapshot_cursor_t cursor = { (uint8_t*)buffer + RDSPARSER_SNAPSHOT_HEADER_SIZE, true };
+    rdsparser_snapshot_walk(&cursor, rds);
+
+    rds->features &= RDSPARSER_FEATURE_ALL;
+    rds->station_pi = RDSPARSER_PI_UNKNOWN;
+    rds->station_count = 0;
+    if (rds->last_rt_flag < -1 ||
+        rds->last_rt_flag >= RDSPARSER_RT_FLAG_COUNT)
+    {
+        rds->last_rt_flag = -1;
+    }
+    rdsparser_parser_update(rds);
+    return true;
+}
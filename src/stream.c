@@ -0,0 +1,195 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <librdsparser_private.h>
+#include "parser.h"
+#include "utils.h"
+
+#ifndef RDSPARSER_DISABLE_HEAP
+rdsparser_stream_t*
+rdsparser_stream_new(rdsparser_t *rds)
+{
+    rdsparser_stream_t *stream = malloc(sizeof(rdsparser_stream_t));
+    if (stream)
+    {
+        rdsparser_stream_init(stream, rds);
+    }
+
+    return stream;
+}
+
+void
+rdsparser_stream_free(rdsparser_stream_t *stream)
+{
+    if (stream)
+    {
+        free(stream);
+    }
+}
+#endif
+
+void
+rdsparser_stream_init(rdsparser_stream_t *stream,
+                      rdsparser_t        *rds)
+{
+    stream->rds = rds;
+    rdsparser_stream_reset(stream);
+}
+
+void
+rdsparser_stream_reset(rdsparser_stream_t *stream)
+{
+    stream->carry_length = 0;
+    stream->overflow = false;
+    stream->parsed = 0;
+    stream->invalid = 0;
+}
+
+static size_t
+rdsparser_stream_line(rdsparser_stream_t *stream,
+                      const char         *line,
+                      size_t              length)
+{
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    if (length &&
+        line[length - 1] == '\r')
+    {
+        length--;
+    }
+
+    if (length == 0)
+    {
+        /* Empty line */
+        return 0;
+    }
+
+    if (rdsparser_utils_convert_n(line, length, data, errors))
+    {
+        rdsparser_parser_process(stream->rds, data, errors);
+        stream->parsed++;
+        return 1;
+    }
+
+    stream->invalid++;
+    return 0;
+}
+
+static void
+rdsparser_stream_append(rdsparser_stream_t *stream,
+                        const char         *buffer,
+                        size_t              length)
+{
+    if (stream->overflow)
+    {
+        return;
+    }
+
+    if (stream->carry_length + length > sizeof(stream->carry))
+    {
+        /* Too long for a valid line, wait for its end */
+        stream->overflow = true;
+        return;
+    }
+
+    memcpy(stream->carry + stream->carry_length, buffer, length);
+    stream->carry_length += (uint8_t)length;
+}
+
+static size_t
+rdsparser_stream_complete(rdsparser_stream_t *stream)
+{
+    size_t parsed = 0;
+
+    if (stream->overflow)
+    {
+        stream->invalid++;
+    }
+    else
+    {
+        parsed = rdsparser_stream_line(stream, stream->carry, stream->carry_length);
+    }
+
+    stream->carry_length = 0;
+    stream->overflow = false;
+    return parsed;
+}
+
+size_t
+rdsparser_stream_feed(rdsparser_stream_t *stream,
+                      const char         *buffer,
+                      size_t              length)
+{
+    size_t parsed = 0;
+
+    while (length)
+    {
+        const char *end = memchr(buffer, '\n', length);
+        const size_t line_length = (end ? (size_t)(end - buffer) : length);
+
+        if (end == NULL)
+        {
+            /* Partial line, carry it over to the next call */
+            rdsparser_stream_append(stream, buffer, line_length);
+            break;
+        }
+
+        if (stream->carry_length ||
+            stream->overflow)
+        {
+            rdsparser_stream_append(stream, buffer, line_length);
+            parsed += rdsparser_stream_complete(stream);
+        }
+        else
+        {
+            /* Complete line within the buffer, parse it in place */
+            parsed += rdsparser_stream_line(stream, buffer, line_length);
+        }
+
+        buffer += line_length + 1;
+        length -= line_length + 1;
+    }
+
+    return parsed;
+}
+
+size_t
+rdsparser_stream_flush(rdsparser_stream_t *stream)
+{
+    if (stream->carry_length ||
+        stream->overflow)
+    {
+        return rdsparser_stream_complete(stream);
+    }
+
+    return 0;
+}
+
+uint32_t
+rdsparser_stream_get_parsed(const rdsparser_stream_t *stream)
+{
+    return stream->parsed;
+}
+
+uint32_t
+rdsparser_stream_get_invalid(const rdsparser_stream_t *stream)
+{
+    return stream->invalid;
+}
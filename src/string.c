@@ -19,63 +19,214 @@
 #include <librdsparser_private.h>
 #include "string.h"
 
+#if defined(RDSPARSER_COMPACT_STRINGS) || !defined(RDSPARSER_DISABLE_UNICODE)
+/* Basic code table (G0), indexed directly by the RDS code */
+static const uint16_t rdsparser_string_charset_g0[256] =
+{
+    /* 0x00-0x1F: control codes */
+    L' ', L' ', L' ', L' ', L' ', L' ', L' ', L' ',
+    L' ', L' ', L' ', L' ', L' ', L' ', L' ', L' ',
+    L' ', L' ', L' ', L' ', L' ', L' ', L' ', L' ',
+    L' ', L' ', L' ', L' ', L' ', L' ', L' ', L' ',
+    L' ', L'!', L'"', L'#', L'¤', L'%', L'&', L'\'',
+    L'(', L')', L'*', L'+', L',', L'-', L'.', L'/',
+    L'0', L'1', L'2', L'3', L'4', L'5', L'6', L'7',
+    L'8', L'9', L':', L';', L'<', L'=', L'>', L'?',
+    L'@', L'A', L'B', L'C', L'D', L'E', L'F', L'G',
+    L'H', L'I', L'J', L'K', L'L', L'M', L'N', L'O',
+    L'P', L'Q', L'R', L'S', L'T', L'U', L'V', L'W',
+    L'X', L'Y', L'Z', L'[', L'\\',L']', L'―', L'_',
+    L'‖', L'a', L'b', L'c', L'd', L'e', L'f', L'g',
+    L'h', L'i', L'j', L'k', L'l', L'm', L'n', L'o',
+    L'p', L'q', L'r', L's', L't', L'u', L'v', L'w',
+    L'x', L'y', L'z', L'{', L'|', L'}', L'¯', L' ',
+    L'á', L'à', L'é', L'è', L'í', L'ì', L'ó', L'ò',
+    L'ú', L'ù', L'Ñ', L'Ç', L'Ş', L'β', L'¡', L'Ĳ',
+    L'â', L'ä', L'ê', L'ë', L'î', L'ï', L'ô', L'ö',
+    L'û', L'ü', L'ñ', L'ç', L'ş', L'ǧ', L'ı', L'ĳ',
+    L'ª', L'α', L'©', L'‰', L'Ǧ', L'ě', L'ň', L'ő',
+    L'π', L'€', L'£', L'$', L'←', L'↑', L'→', L'↓',
+    L'º', L'¹', L'²', L'³', L'±', L'İ', L'ń', L'ű',
+    L'µ', L'¿', L'÷', L'°', L'¼', L'½', L'¾', L'§',
+    L'Á', L'À', L'É', L'È', L'Í', L'Ì', L'Ó', L'Ò',
+    L'Ú', L'Ù', L'Ř', L'Č', L'Š', L'Ž', L'Ð', L'Ŀ',
+    L'Â', L'Ä', L'Ê', L'Ë', L'Î', L'Ï', L'Ô', L'Ö',
+    L'Û', L'Ü', L'ř', L'č', L'š', L'ž', L'đ', L'ŀ',
+    L'Ã', L'Å', L'Æ', L'Œ', L'ŷ', L'Ý', L'Õ', L'Ø',
+    L'Þ', L'Ŋ', L'Ŕ', L'Ć', L'Ś', L'Ź', L'Ŧ', L'ð',
+    L'ã', L'å', L'æ', L'œ', L'ŵ', L'ý', L'õ', L'ø',
+    L'þ', L'ŋ', L'ŕ', L'ć', L'ś', L'ź', L'ŧ', L' '
+};
+
+/* The G1 and G2 tables of EN 50067 Annex E are not included,
+   their codes are decoded with the G0 table */
+static const uint16_t *const rdsparser_string_charset[RDSPARSER_STRING_TABLE_COUNT] =
+{
+    rdsparser_string_charset_g0,
+    rdsparser_string_charset_g0,
+    rdsparser_string_charset_g0
+};
+
+#ifdef RDSPARSER_COMPACT_STRINGS
+static uint8_t
+rdsparser_string_charset_find(rdsparser_string_table_t table,
+                              uint32_t                 code_point)
+{
+    const uint16_t *charset = rdsparser_string_charset[table];
+    const uint16_t offset = 0x20;
+
+    for (uint16_t i = offset; i < 256; i++)
+    {
+        if (charset[i] == code_point)
+        {
+            return (uint8_t)i;
+        }
+    }
+
+    return ' ';
+}
+#endif
+#endif
+
+static rdsparser_string_header_t*
+rdsparser_string_get_header(const rdsparser_string_t *string)
+{
+    return (rdsparser_string_header_t*)string;
+}
+
 void
 rdsparser_string_init(rdsparser_string_t *string,
                       uint8_t             max_length)
 {
-    *string = max_length;
+    rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+    header->size = max_length;
+    header->table = RDSPARSER_STRING_TABLE_G0;
 }
 
 static uint8_t
 rdsparser_string_get_size(const rdsparser_string_t *string)
 {
-    return (uint8_t)string[0];
+    return rdsparser_string_get_header(string)->size;
 }
 
 uint8_t
 rdsparser_string_get_length(const rdsparser_string_t *string)
 {
-    const uint8_t size = rdsparser_string_get_size(string);
-    for (uint8_t i = 0; i < size; i++)
-    {
-        const rdsparser_string_char_t *content = rdsparser_string_get_content(string);
-        if (content[i] == '\0')
-        {
-            return i;
-        }
-    }
-
-    return size;
+    return rdsparser_string_get_header(string)->length;
 }
 
 const rdsparser_string_char_t*
 rdsparser_string_get_content(const rdsparser_string_t *string)
 {
-    return (string + 1);
+    return (string + RDSPARSER_STRING_HEADER_SIZE);
 }
 
 const rdsparser_string_error_t*
 rdsparser_string_get_errors(const rdsparser_string_t *string)
 {
     const uint8_t size = rdsparser_string_get_size(string);
-    return (uint8_t*)(string + 1 + size + 1);
+    return (uint8_t*)(string + RDSPARSER_STRING_HEADER_SIZE + size + 1);
 }
 
 bool
 rdsparser_string_get_available(const rdsparser_string_t *string)
 {
-    const uint8_t size = rdsparser_string_get_size(string);
-    const rdsparser_string_error_t *errors = rdsparser_string_get_errors(string);
+    return (rdsparser_string_get_available_count(string) > 0);
+}
 
-    for (uint8_t i = 0; i < size; i++)
+uint8_t
+rdsparser_string_get_available_count(const rdsparser_string_t *string)
+{
+    const rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+    return header->size - header->error_count[RDSPARSER_STRING_ERROR_UNCORRECTABLE];
+}
+
+rdsparser_string_error_t
+rdsparser_string_get_min_error(const rdsparser_string_t *string)
+{
+    const rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+    rdsparser_string_error_t error;
+
+    for (error = RDSPARSER_STRING_ERROR_NONE; error < RDSPARSER_STRING_ERROR_UNCORRECTABLE; error++)
     {
-        if (errors[i] != RDSPARSER_STRING_ERROR_UNCORRECTABLE)
+        if (header->error_count[error])
         {
-            return true;
+            break;
         }
     }
 
-    return false;
+    return error;
+}
+
+rdsparser_string_error_t
+rdsparser_string_get_max_error(const rdsparser_string_t *string)
+{
+    const rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+
+    for (rdsparser_string_error_t error = RDSPARSER_STRING_ERROR_UNCORRECTABLE; error > RDSPARSER_STRING_ERROR_NONE; error--)
+    {
+        if (header->error_count[error - 1])
+        {
+            return error - 1;
+        }
+    }
+
+    return RDSPARSER_STRING_ERROR_UNCORRECTABLE;
+}
+
+rdsparser_string_table_t
+rdsparser_string_get_table(const rdsparser_string_t *string)
+{
+    return rdsparser_string_get_header(string)->table;
+}
+
+static void
+rdsparser_string_set_changed(rdsparser_string_header_t *header,
+                             uint8_t                    position)
+{
+    if (header->changed_reset)
+    {
+        for (uint8_t i = 0; i < sizeof(header->changed); i++)
+        {
+            header->changed[i] = 0;
+        }
+        header->changed_reset = false;
+    }
+
+    header->changed[position >> 3] |= (uint8_t)(1 << (position & 7));
+}
+
+static void
+rdsparser_string_set_changed_all(rdsparser_string_t *string)
+{
+    rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+    const uint8_t size = rdsparser_string_get_size(string);
+
+    for (uint8_t i = 0; i < size; i++)
+    {
+        rdsparser_string_set_changed(header, i);
+    }
+}
+
+uint64_t
+rdsparser_string_get_changed(const rdsparser_string_t *string)
+{
+    const rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+    uint64_t changed = 0;
+
+    for (uint8_t i = 0; i < sizeof(header->changed); i++)
+    {
+        changed |= (uint64_t)header->changed[i] << (8 * i);
+    }
+
+    return changed;
+}
+
+void
+rdsparser_string_begin_update(rdsparser_string_t *string)
+{
+    /* The positions are reset on the next change */
+    rdsparser_string_get_header(string)->changed_reset = true;
 }
 
 void
@@ -85,11 +236,67 @@ rdsparser_string_clear(rdsparser_string_t *string)
     rdsparser_string_char_t *content = (rdsparser_string_char_t*)rdsparser_string_get_content(string);
     rdsparser_string_error_t *errors = (rdsparser_string_error_t*)rdsparser_string_get_errors(string);
 
+    rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+
     for (uint8_t i = 0; i < size; i++)
     {
         content[i] = ' ';
         errors[i] = RDSPARSER_STRING_ERROR_UNCORRECTABLE;
     }
+
+    header->table = RDSPARSER_STRING_TABLE_G0;
+    header->length = size;
+    for (uint8_t i = 0; i < RDSPARSER_STRING_ERROR_UNCORRECTABLE; i++)
+    {
+        header->error_count[i] = 0;
+    }
+    header->error_count[RDSPARSER_STRING_ERROR_UNCORRECTABLE] = size;
+    header->utf8_valid = false;
+    rdsparser_string_set_changed_all(string);
+}
+
+static uint8_t
+rdsparser_string_find_length(const rdsparser_string_t *string,
+                             uint8_t                   start)
+{
+    const uint8_t size = rdsparser_string_get_size(string);
+    const rdsparser_string_char_t *content = rdsparser_string_get_content(string);
+
+    for (uint8_t i = start; i < size; i++)
+    {
+        if (content[i] == '\0')
+        {
+            return i;
+        }
+    }
+
+    return size;
+}
+
+void
+rdsparser_string_refresh(rdsparser_string_t *string)
+{
+    const uint8_t size = rdsparser_string_get_size(string);
+    rdsparser_string_error_t *errors = (rdsparser_string_error_t*)rdsparser_string_get_errors(string);
+    rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+
+    for (uint8_t i = 0; i <= RDSPARSER_STRING_ERROR_UNCORRECTABLE; i++)
+    {
+        header->error_count[i] = 0;
+    }
+
+    for (uint8_t i = 0; i < size; i++)
+    {
+        if (errors[i] > RDSPARSER_STRING_ERROR_UNCORRECTABLE)
+        {
+            errors[i] = RDSPARSER_STRING_ERROR_UNCORRECTABLE;
+        }
+        header->error_count[errors[i]]++;
+    }
+
+    header->length = rdsparser_string_find_length(string, 0);
+    header->utf8_valid = false;
+    rdsparser_string_set_changed_all(string);
 }
 
 static rdsparser_string_error_t
@@ -101,53 +308,246 @@ rdsparser_string_calculate_error(rdsparser_block_error_t info_error,
 }
 
 static rdsparser_string_char_t
-rdsparser_string_convert(uint8_t input)
+rdsparser_string_convert(rdsparser_string_table_t table,
+                         uint8_t                  input)
 {
     if (input == '\r')
     {
         return '\0';
     }
 
-#ifdef RDSPARSER_DISABLE_UNICODE
+#if defined(RDSPARSER_COMPACT_STRINGS) || defined(RDSPARSER_DISABLE_UNICODE)
+    /* Raw RDS code, converted on request */
     return input;
 #else
-    const uint8_t offset = 0x20;
-    const wchar_t charset[] =
-    {
-        L' ', L'!', L'"', L'#', L'¤', L'%', L'&', L'\'',
-        L'(', L')', L'*', L'+', L',', L'-', L'.', L'/',
-        L'0', L'1', L'2', L'3', L'4', L'5', L'6', L'7',
-        L'8', L'9', L':', L';', L'<', L'=', L'>', L'?',
-        L'@', L'A', L'B', L'C', L'D', L'E', L'F', L'G',
-        L'H', L'I', L'J', L'K', L'L', L'M', L'N', L'O',
-        L'P', L'Q', L'R', L'S', L'T', L'U', L'V', L'W',
-        L'X', L'Y', L'Z', L'[', L'\\',L']', L'―', L'_',
-        L'‖', L'a', L'b', L'c', L'd', L'e', L'f', L'g',
-        L'h', L'i', L'j', L'k', L'l', L'm', L'n', L'o',
-        L'p', L'q', L'r', L's', L't', L'u', L'v', L'w',
-        L'x', L'y', L'z', L'{', L'|', L'}', L'¯', L' ',
-        L'á', L'à', L'é', L'è', L'í', L'ì', L'ó', L'ò',
-        L'ú', L'ù', L'Ñ', L'Ç', L'Ş', L'β', L'¡', L'Ĳ',
-        L'â', L'ä', L'ê', L'ë', L'î', L'ï', L'ô', L'ö',
-        L'û', L'ü', L'ñ', L'ç', L'ş', L'ǧ', L'ı', L'ĳ',
-        L'ª', L'α', L'©', L'‰', L'Ǧ', L'ě', L'ň', L'ő',
-        L'π', L'€', L'£', L'$', L'←', L'↑', L'→', L'↓',
-        L'º', L'¹', L'²', L'³', L'±', L'İ', L'ń', L'ű',
-        L'µ', L'¿', L'÷', L'°', L'¼', L'½', L'¾', L'§',
-        L'Á', L'À', L'É', L'È', L'Í', L'Ì', L'Ó', L'Ò',
-        L'Ú', L'Ù', L'Ř', L'Č', L'Š', L'Ž', L'Ð', L'Ŀ',
-        L'Â', L'Ä', L'Ê', L'Ë', L'Î', L'Ï', L'Ô', L'Ö',
-        L'Û', L'Ü', L'ř', L'č', L'š', L'ž', L'đ', L'ŀ',
-        L'Ã', L'Å', L'Æ', L'Œ', L'ŷ', L'Ý', L'Õ', L'Ø',
-        L'Þ', L'Ŋ', L'Ŕ', L'Ć', L'Ś', L'Ź', L'Ŧ', L'ð',
-        L'ã', L'å', L'æ', L'œ', L'ŵ', L'ý', L'õ', L'ø',
-        L'þ', L'ŋ', L'ŕ', L'ć', L'ś', L'ź', L'ŧ', L' '
-    };
-
-    /* TODO: Implement SO and LS2 tables (and charset detection) */
-    const wchar_t fallback_char = L' ';
-    return (input < offset ? fallback_char : charset[input - offset]);
+    return (rdsparser_string_char_t)rdsparser_string_charset[table][input];
+#endif
+}
+
+uint32_t
+rdsparser_string_decode(const rdsparser_string_t *string,
+                        rdsparser_string_char_t   character)
+{
+#ifdef RDSPARSER_COMPACT_STRINGS
+    if (character == '\0')
+    {
+        return 0;
+    }
+    return rdsparser_string_charset[rdsparser_string_get_table(string)][character];
+#else
+    return (uint32_t)character;
+#endif
+}
+
+rdsparser_string_char_t
+rdsparser_string_encode(const rdsparser_string_t *string,
+                        uint32_t                  code_point)
+{
+#ifdef RDSPARSER_COMPACT_STRINGS
+    if (code_point == 0)
+    {
+        return '\0';
+    }
+    return rdsparser_string_charset_find(rdsparser_string_get_table(string), code_point);
+#else
+    if (sizeof(rdsparser_string_char_t) == 1 &&
+        code_point > 0xFF)
+    {
+        /* Not representable without the unicode support */
+        return ' ';
+    }
+    return (rdsparser_string_char_t)code_point;
+#endif
+}
+
+void
+rdsparser_string_set_table(rdsparser_string_t       *string,
+                           rdsparser_string_table_t  table)
+{
+    rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+
+    /* The already received characters are not converted: only the raw
+       codes stored by the compact build are decoded with the new table */
+    header->table = table;
+    header->utf8_valid = false;
+    rdsparser_string_set_changed_all(string);
+}
+
+#ifndef RDSPARSER_DISABLE_UNICODE
+size_t
+rdsparser_string_to_wchar(const rdsparser_string_t *string,
+                          wchar_t                  *output,
+                          size_t                    size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    const rdsparser_string_char_t *content = rdsparser_string_get_content(string);
+    const uint8_t length = rdsparser_string_get_length(string);
+    size_t i;
+
+    for (i = 0; i < length && i < size - 1; i++)
+    {
+        output[i] = (wchar_t)rdsparser_string_decode(string, content[i]);
+    }
+
+    output[i] = L'\0';
+    return i;
+}
+#endif
+
+static uint8_t
+rdsparser_string_utf8_encode(uint32_t  code_point,
+                             char     *output)
+{
+    if (code_point < 0x80)
+    {
+        output[0] = (char)code_point;
+        return 1;
+    }
+
+    if (code_point < 0x800)
+    {
+        output[0] = (char)(0xC0 | (code_point >> 6));
+        output[1] = (char)(0x80 | (code_point & 0x3F));
+        return 2;
+    }
+
+    if (code_point > 0xFFFF ||
+        (code_point >= 0xD800 && code_point <= 0xDFFF))
+    {
+        /* All code tables are within the BMP */
+        output[0] = ' ';
+        return 1;
+    }
+
+    output[0] = (char)(0xE0 | (code_point >> 12));
+    output[1] = (char)(0x80 | ((code_point >> 6) & 0x3F));
+    output[2] = (char)(0x80 | (code_point & 0x3F));
+    return 3;
+}
+
+static uint8_t
+rdsparser_string_utf8_build(const rdsparser_string_t *string,
+                            char                     *output)
+{
+    const rdsparser_string_char_t *content = rdsparser_string_get_content(string);
+    const uint8_t length = rdsparser_string_get_length(string);
+    uint8_t utf8_length = 0;
+
+    for (uint8_t i = 0; i < length; i++)
+    {
+        utf8_length += rdsparser_string_utf8_encode(rdsparser_string_decode(string, content[i]),
+                                                    output + utf8_length);
+    }
+
+    output[utf8_length] = '\0';
+    return utf8_length;
+}
+
+#ifndef RDSPARSER_COMPACT_STRINGS
+static inline char*
+rdsparser_string_get_utf8(const rdsparser_string_t *string)
+{
+    const uint8_t size = rdsparser_string_get_size(string);
+    return (char*)(string + RDSPARSER_STRING_HEADER_SIZE + size + 1 + size / sizeof(rdsparser_string_char_t));
+}
+#endif
+
+void
+rdsparser_string_update_utf8(rdsparser_string_t *string)
+{
+#ifndef RDSPARSER_COMPACT_STRINGS
+    /* Called by the parser after a change, so that
+       rdsparser_string_to_utf8() only reads the string */
+    rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+    if (!header->utf8_valid)
+    {
+        header->utf8_length = rdsparser_string_utf8_build(string, rdsparser_string_get_utf8(string));
+        header->utf8_valid = true;
+    }
+#endif
+}
+
+size_t
+rdsparser_string_to_utf8(const rdsparser_string_t *string,
+                         char                     *output,
+                         size_t                    size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    char buffer[RDSPARSER_STRING_UTF8_SIZE(RDSPARSER_RT_LENGTH)];
+    const char *utf8 = buffer;
+    size_t length;
+
+#ifndef RDSPARSER_COMPACT_STRINGS
+    const rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+    if (header->utf8_valid)
+    {
+        utf8 = rdsparser_string_get_utf8(string);
+        length = header->utf8_length;
+    }
+    else
 #endif
+    {
+        /* Not cached (e.g. after a clear), built on the stack */
+        length = rdsparser_string_utf8_build(string, buffer);
+    }
+
+    if (length > size - 1)
+    {
+        /* Do not split a multi-byte sequence */
+        length = size - 1;
+        while (length > 0 &&
+               (utf8[length] & 0xC0) == 0x80)
+        {
+            length--;
+        }
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+        output[i] = utf8[i];
+    }
+
+    output[length] = '\0';
+    return length;
+}
+
+static bool
+rdsparser_string_get_designation(const char                input[2],
+                                 rdsparser_string_table_t *table)
+{
+    const uint8_t first = (uint8_t)input[0];
+    const uint8_t second = (uint8_t)input[1];
+
+    if (first == 0x0F && second == 0x0F)
+    {
+        /* SI SI */
+        *table = RDSPARSER_STRING_TABLE_G0;
+        return true;
+    }
+
+    if (first == 0x0E && second == 0x0E)
+    {
+        /* SO SO */
+        *table = RDSPARSER_STRING_TABLE_G1;
+        return true;
+    }
+
+    if (first == 0x1B && second == 0x6E)
+    {
+        /* ESC n */
+        *table = RDSPARSER_STRING_TABLE_G2;
+        return true;
+    }
+
+    return false;
 }
 
 static bool
@@ -195,12 +595,12 @@ rdsparser_string_update_single(rdsparser_string_t      *string,
                so use only error-free info and data */
             return false;
         }
-#ifdef RDSPARSER_DISABLE_UNICODE
+#if defined(RDSPARSER_DISABLE_UNICODE) && !defined(RDSPARSER_COMPACT_STRINGS)
         input = ' ';
 #endif
     }
 
-    rdsparser_string_char_t character = rdsparser_string_convert(input);
+    rdsparser_string_char_t character = rdsparser_string_convert(rdsparser_string_get_table(string), input);
     if (output[position] == character &&
         output_errors[position] <= error)
     {
@@ -208,8 +608,30 @@ rdsparser_string_update_single(rdsparser_string_t      *string,
         return false;
     }
 
+    rdsparser_string_header_t *header = rdsparser_string_get_header(string);
+    header->error_count[output_errors[position]]--;
+    header->error_count[error]++;
+    header->utf8_valid = false;
+    rdsparser_string_set_changed(header, position);
+
+    const bool was_end = (output[position] == '\0');
     output[position] = character;
     output_errors[position] = error;
+
+    if (character == '\0')
+    {
+        if (position < header->length)
+        {
+            header->length = position;
+        }
+    }
+    else if (was_end &&
+             position == header->length)
+    {
+        /* The end of the text was overwritten */
+        header->length = rdsparser_string_find_length(string, position + 1);
+    }
+
     return true;
 }
 
@@ -224,6 +646,21 @@ rdsparser_string_update(rdsparser_string_t      *string,
 {
     const uint8_t chunk_length = 2;
     bool changed = false;
+    rdsparser_string_table_t table;
+
+    if (rdsparser_string_get_designation(input, &table))
+    {
+        if (info_error != RDSPARSER_BLOCK_ERROR_NONE ||
+            data_error != RDSPARSER_BLOCK_ERROR_NONE ||
+            rdsparser_string_get_table(string) == table)
+        {
+            /* Only error-free code table switching */
+            return false;
+        }
+
+        rdsparser_string_set_table(string, table);
+        return true;
+    }
 
     for (uint8_t i = 0; i < chunk_length; i++)
     {
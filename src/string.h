@@ -19,6 +19,12 @@
 
 void rdsparser_string_init(rdsparser_string_t *string, uint8_t size);
 void rdsparser_string_clear(rdsparser_string_t *string);
+void rdsparser_string_refresh(rdsparser_string_t *string);
+void rdsparser_string_begin_update(rdsparser_string_t *string);
+void rdsparser_string_set_table(rdsparser_string_t *string, rdsparser_string_table_t table);
+uint32_t rdsparser_string_decode(const rdsparser_string_t *string, rdsparser_string_char_t character);
+rdsparser_string_char_t rdsparser_string_encode(const rdsparser_string_t *string, uint32_t code_point);
+void rdsparser_string_update_utf8(rdsparser_string_t *string);
 bool rdsparser_string_update(rdsparser_string_t *string, const char input[2], rdsparser_block_error_t info_error, rdsparser_block_error_t data_error, uint8_t position, bool progressive, bool allow_eol);
 
 #endif
\ No newline at end of file
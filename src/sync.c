@@ -0,0 +1,561 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdint.h>
+#include <librdsparser_private.h>
+#include "parser.h"
+#include "sync.h"
+
+#define RDSPARSER_SYNC_BLOCK_MASK ((1UL << RDSPARSER_SYNC_BLOCK_BITS) - 1)
+#define RDSPARSER_SYNC_CHECK_MASK ((1U << RDSPARSER_SYNC_CHECK_BITS) - 1)
+#define RDSPARSER_SYNC_OFFSET_NONE 0xFF
+
+/* Two offset words matching in the same bit phase within that many blocks
+   are required to acquire synchronization */
+#define RDSPARSER_SYNC_SEARCH_BLOCKS 8
+/* Synchronization is lost after that many consecutive blocks with errors,
+   corrected ones included, as random data passes as a burst error too often */
+#define RDSPARSER_SYNC_LOSS_BLOCKS 8
+
+#define RDSPARSER_SYNC_BURST_MASK 0xFFFF
+#define RDSPARSER_SYNC_BURST_LEVEL_SHIFT 16
+
+static const uint16_t rdsparser_sync_offsets[RDSPARSER_SYNC_COUNT] =
+{
+    RDSPARSER_SYNC_OFFSET_A,
+    RDSPARSER_SYNC_OFFSET_B,
+    RDSPARSER_SYNC_OFFSET_C,
+    RDSPARSER_SYNC_OFFSET_CP,
+    RDSPARSER_SYNC_OFFSET_D
+};
+
+static const rdsparser_block_t rdsparser_sync_blocks[RDSPARSER_SYNC_COUNT] =
+{
+    RDSPARSER_BLOCK_A,
+    RDSPARSER_BLOCK_B,
+    RDSPARSER_BLOCK_C,
+    RDSPARSER_BLOCK_C,
+    RDSPARSER_BLOCK_D
+};
+
+/* Remainder of (v << 18) modulo g(x) = x^10 + x^8 + x^7 + x^5 + x^4 + x^3 + 1 */
+static const uint16_t rdsparser_sync_table_hi[256] =
+{
+    0x000, 0x0DC, 0x1B8, 0x164, 0x370, 0x3AC, 0x2C8, 0x214,
+    0x359, 0x385, 0x2E1, 0x23D, 0x029, 0x0F5, 0x191, 0x14D,
+    0x30B, 0x3D7, 0x2B3, 0x26F, 0x07B, 0x0A7, 0x1C3, 0x11F,
+    0x052, 0x08E, 0x1EA, 0x136, 0x322, 0x3FE, 0x29A, 0x246,
+    0x3AF, 0x373, 0x217, 0x2CB, 0x0DF, 0x003, 0x167, 0x1BB,
+    0x0F6, 0x02A, 0x14E, 0x192, 0x386, 0x35A, 0x23E, 0x2E2,
+    0x0A4, 0x078, 0x11C, 0x1C0, 0x3D4, 0x308, 0x26C, 0x2B0,
+    0x3FD, 0x321, 0x245, 0x299, 0x08D, 0x051, 0x135, 0x1E9,
+    0x2E7, 0x23B, 0x35F, 0x383, 0x197, 0x14B, 0x02F, 0x0F3,
+    0x1BE, 0x162, 0x006, 0x0DA, 0x2CE, 0x212, 0x376, 0x3AA,
+    0x1EC, 0x130, 0x054, 0x088, 0x29C, 0x240, 0x324, 0x3F8,
+    0x2B5, 0x269, 0x30D, 0x3D1, 0x1C5, 0x119, 0x07D, 0x0A1,
+    0x148, 0x194, 0x0F0, 0x02C, 0x238, 0x2E4, 0x380, 0x35C,
+    0x211, 0x2CD, 0x3A9, 0x375, 0x161, 0x1BD, 0x0D9, 0x005,
+    0x243, 0x29F, 0x3FB, 0x327, 0x133, 0x1EF, 0x08B, 0x057,
+    0x11A, 0x1C6, 0x0A2, 0x07E, 0x26A, 0x2B6, 0x3D2, 0x30E,
+    0x077, 0x0AB, 0x1CF, 0x113, 0x307, 0x3DB, 0x2BF, 0x263,
+    0x32E, 0x3F2, 0x296, 0x24A, 0x05E, 0x082, 0x1E6, 0x13A,
+    0x37C, 0x3A0, 0x2C4, 0x218, 0x00C, 0x0D0, 0x1B4, 0x168,
+    0x025, 0x0F9, 0x19D, 0x141, 0x355, 0x389, 0x2ED, 0x231,
+    0x3D8, 0x304, 0x260, 0x2BC, 0x0A8, 0x074, 0x110, 0x1CC,
+    0x081, 0x05D, 0x139, 0x1E5, 0x3F1, 0x32D, 0x249, 0x295,
+    0x0D3, 0x00F, 0x16B, 0x1B7, 0x3A3, 0x37F, 0x21B, 0x2C7,
+    0x38A, 0x356, 0x232, 0x2EE, 0x0FA, 0x026, 0x142, 0x19E,
+    0x290, 0x24C, 0x328, 0x3F4, 0x1E0, 0x13C, 0x058, 0x084,
+    0x1C9, 0x115, 0x071, 0x0AD, 0x2B9, 0x265, 0x301, 0x3DD,
+    0x19B, 0x147, 0x023, 0x0FF, 0x2EB, 0x237, 0x353, 0x38F,
+    0x2C2, 0x21E, 0x37A, 0x3A6, 0x1B2, 0x16E, 0x00A, 0x0D6,
+    0x13F, 0x1E3, 0x087, 0x05B, 0x24F, 0x293, 0x3F7, 0x32B,
+    0x266, 0x2BA, 0x3DE, 0x302, 0x116, 0x1CA, 0x0AE, 0x072,
+    0x234, 0x2E8, 0x38C, 0x350, 0x144, 0x198, 0x0FC, 0x020,
+    0x16D, 0x1B1, 0x0D5, 0x009, 0x21D, 0x2C1, 0x3A5, 0x379
+};
+
+/* Remainder of (v << 10) modulo g(x) */
+static const uint16_t rdsparser_sync_table_lo[256] =
+{
+    0x000, 0x1B9, 0x372, 0x2CB, 0x35D, 0x2E4, 0x02F, 0x196,
+    0x303, 0x2BA, 0x071, 0x1C8, 0x05E, 0x1E7, 0x32C, 0x295,
+    0x3BF, 0x206, 0x0CD, 0x174, 0x0E2, 0x15B, 0x390, 0x229,
+    0x0BC, 0x105, 0x3CE, 0x277, 0x3E1, 0x258, 0x093, 0x12A,
+    0x2C7, 0x37E, 0x1B5, 0x00C, 0x19A, 0x023, 0x2E8, 0x351,
+    0x1C4, 0x07D, 0x2B6, 0x30F, 0x299, 0x320, 0x1EB, 0x052,
+    0x178, 0x0C1, 0x20A, 0x3B3, 0x225, 0x39C, 0x157, 0x0EE,
+    0x27B, 0x3C2, 0x109, 0x0B0, 0x126, 0x09F, 0x254, 0x3ED,
+    0x037, 0x18E, 0x345, 0x2FC, 0x36A, 0x2D3, 0x018, 0x1A1,
+    0x334, 0x28D, 0x046, 0x1FF, 0x069, 0x1D0, 0x31B, 0x2A2,
+    0x388, 0x231, 0x0FA, 0x143, 0x0D5, 0x16C, 0x3A7, 0x21E,
+    0x08B, 0x132, 0x3F9, 0x240, 0x3D6, 0x26F, 0x0A4, 0x11D,
+    0x2F0, 0x349, 0x182, 0x03B, 0x1AD, 0x014, 0x2DF, 0x366,
+    0x1F3, 0x04A, 0x281, 0x338, 0x2AE, 0x317, 0x1DC, 0x065,
+    0x14F, 0x0F6, 0x23D, 0x384, 0x212, 0x3AB, 0x160, 0x0D9,
+    0x24C, 0x3F5, 0x13E, 0x087, 0x111, 0x0A8, 0x263, 0x3DA,
+    0x06E, 0x1D7, 0x31C, 0x2A5, 0x333, 0x28A, 0x041, 0x1F8,
+    0x36D, 0x2D4, 0x01F, 0x1A6, 0x030, 0x189, 0x342, 0x2FB,
+    0x3D1, 0x268, 0x0A3, 0x11A, 0x08C, 0x135, 0x3FE, 0x247,
+    0x0D2, 0x16B, 0x3A0, 0x219, 0x38F, 0x236, 0x0FD, 0x144,
+    0x2A9, 0x310, 0x1DB, 0x062, 0x1F4, 0x04D, 0x286, 0x33F,
+    0x1AA, 0x013, 0x2D8, 0x361, 0x2F7, 0x34E, 0x185, 0x03C,
+    0x116, 0x0AF, 0x264, 0x3DD, 0x24B, 0x3F2, 0x139, 0x080,
+    0x215, 0x3AC, 0x167, 0x0DE, 0x148, 0x0F1, 0x23A, 0x383,
+    0x059, 0x1E0, 0x32B, 0x292, 0x304, 0x2BD, 0x076, 0x1CF,
+    0x35A, 0x2E3, 0x028, 0x191, 0x007, 0x1BE, 0x375, 0x2CC,
+    0x3E6, 0x25F, 0x094, 0x12D, 0x0BB, 0x102, 0x3C9, 0x270,
+    0x0E5, 0x15C, 0x397, 0x22E, 0x3B8, 0x201, 0x0CA, 0x173,
+    0x29E, 0x327, 0x1EC, 0x055, 0x1C3, 0x07A, 0x2B1, 0x308,
+    0x19D, 0x024, 0x2EF, 0x356, 0x2C0, 0x379, 0x1B2, 0x00B,
+    0x121, 0x098, 0x253, 0x3EA, 0x27C, 0x3C5, 0x10E, 0x0B7,
+    0x222, 0x39B, 0x150, 0x0E9, 0x17F, 0x0C6, 0x20D, 0x3B4
+};
+
+/* Error syndrome to the correction of information bits [15:0] with
+ * the error level in [17:16]. All bursts up to 5 bits have unique
+ * syndromes: 1-2 flipped bits are reported as a small error,
+ * 3-5 flipped bits as a large one. Other syndromes are uncorrectable. */
+static const uint32_t rdsparser_sync_table_burst[1 << RDSPARSER_SYNC_CHECK_BITS] =
+{
+    0x00000, 0x10000, 0x10000, 0x10000, 0x10000, 0x10000, 0x10000, 0x20000,
+    0x10000, 0x10000, 0x10000, 0x20000, 0x10000, 0x20000, 0x20000, 0x20000,
+    0x10000, 0x10000, 0x10000, 0x20000, 0x10000, 0x20000, 0x20000, 0x20000,
+    0x10000, 0x20000, 0x20000, 0x20000, 0x20000, 0x20000, 0x20000, 0x20000,
+    0x10000, 0x30000, 0x10000, 0x30000, 0x10000, 0x29800, 0x20000, 0x30000,
+    0x10000, 0x10C00, 0x20000, 0x30000, 0x20000, 0x30000, 0x20000, 0x10006,
+    0x10000, 0x30000, 0x20000, 0x30000, 0x20000, 0x30000, 0x20000, 0x10040,
+    0x20000, 0x20001, 0x20000, 0x30000, 0x20000, 0x30000, 0x20000, 0x30000,
+    0x10000, 0x30000, 0x30000, 0x30000, 0x10000, 0x30000, 0x30000, 0x20C80,
+    0x10000, 0x30000, 0x30000, 0x20003, 0x20000, 0x30000, 0x30000, 0x30000,
+    0x10000, 0x30000, 0x11800, 0x30000, 0x20000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x100C0, 0x30000, 0x30000, 0x20000, 0x20004, 0x1000C, 0x30000,
+    0x10000, 0x30000, 0x30000, 0x30000, 0x20000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x2004C, 0x30000, 0x30000, 0x20000, 0x30000, 0x10080, 0x30000,
+    0x20000, 0x1000A, 0x20002, 0x30000, 0x20000, 0x30000, 0x30000, 0x18000,
+    0x20000, 0x20001, 0x30000, 0x11400, 0x20000, 0x30000, 0x30000, 0x30000,
+    0x10000, 0x2A800, 0x30000, 0x30000, 0x30000, 0x201C0, 0x30000, 0x30000,
+    0x10000, 0x30000, 0x30000, 0x20058, 0x30000, 0x23C00, 0x21900, 0x30000,
+    0x10000, 0x30000, 0x30000, 0x2001E, 0x30000, 0x2000F, 0x20007, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x20D80, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x10000, 0x30000, 0x30000, 0x30000, 0x13000, 0x30000, 0x30000, 0x21500,
+    0x20000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x10180, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x10001, 0x20009, 0x30000, 0x10018, 0x30000, 0x30000, 0x30000,
+    0x10000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x20003, 0x30000, 0x10012, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x20098, 0x2B000, 0x30000, 0x20054, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x30000, 0x10100, 0x30000, 0x30000, 0x12400,
+    0x20000, 0x30000, 0x10014, 0x30000, 0x20005, 0x200D8, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x10140, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x20002, 0x30000, 0x30000, 0x20D00, 0x12800, 0x30000,
+    0x20000, 0x20001, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x10000, 0x30000, 0x30000, 0x10008, 0x30000, 0x20019, 0x30000, 0x30000,
+    0x30000, 0x2003A, 0x20380, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x10000, 0x2007C, 0x30000, 0x30000, 0x30000, 0x30000, 0x200B0, 0x30000,
+    0x30000, 0x30000, 0x27800, 0x30000, 0x23200, 0x30000, 0x30000, 0x21700,
+    0x10000, 0x200F0, 0x30000, 0x20F80, 0x30000, 0x30000, 0x2003C, 0x30000,
+    0x30000, 0x30000, 0x2001F, 0x30000, 0x2000E, 0x30000, 0x30000, 0x20006,
+    0x20000, 0x30000, 0x30000, 0x27400, 0x30000, 0x23E00, 0x21B00, 0x30000,
+    0x30000, 0x10001, 0x30000, 0x30000, 0x30000, 0x203C0, 0x30000, 0x2E000,
+    0x10000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x16000, 0x30000, 0x30000, 0x20003, 0x30000, 0x20F00, 0x22A00, 0x20070,
+    0x20000, 0x30000, 0x30000, 0x20340, 0x30000, 0x30000, 0x30000, 0x20036,
+    0x30000, 0x30000, 0x30000, 0x20015, 0x30000, 0x10004, 0x30000, 0x30000,
+    0x20000, 0x26C00, 0x30000, 0x30000, 0x10300, 0x30000, 0x30000, 0x22600,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x2F800, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x10002, 0x30000, 0x20013, 0x30000, 0x30000, 0x30000,
+    0x10030, 0x20001, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x10000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x10240,
+    0x20000, 0x20E00, 0x30000, 0x20170, 0x30000, 0x30000, 0x20007, 0x14400,
+    0x30000, 0x30000, 0x10024, 0x2D000, 0x30000, 0x200E8, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x30000, 0x20130, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x200A8, 0x30000, 0x30000, 0x20064, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x30000, 0x30000, 0x10022, 0x30000, 0x30000,
+    0x10200, 0x10001, 0x30000, 0x30000, 0x30000, 0x30000, 0x14800, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x21600, 0x10028, 0x25C00, 0x30000, 0x30000,
+    0x2000B, 0x2C800, 0x201B0, 0x20003, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x10280, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x202C0, 0x30000, 0x30000, 0x20005, 0x30000, 0x30000, 0x2000D,
+    0x30000, 0x30000, 0x21A00, 0x2002E, 0x15000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x20002, 0x20068, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x10001, 0x30000, 0x30000, 0x30000, 0x201F0, 0x30000, 0x20E80,
+    0x10000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x10011, 0x30000,
+    0x30000, 0x30000, 0x20032, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x26800, 0x20074, 0x30000, 0x20700, 0x200B8, 0x30000, 0x12200,
+    0x30000, 0x30000, 0x30000, 0x10120, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x10000, 0x30000, 0x200F8, 0x20740, 0x30000, 0x20034, 0x30000, 0x30000,
+    0x30000, 0x20017, 0x30000, 0x30000, 0x20160, 0x30000, 0x30000, 0x20006,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x2F000, 0x30000, 0x30000, 0x30000,
+    0x26400, 0x20001, 0x30000, 0x30000, 0x30000, 0x20B00, 0x22E00, 0x30000,
+    0x10000, 0x30000, 0x201E0, 0x27000, 0x30000, 0x23A00, 0x21F00, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x20003, 0x20078, 0x207C0, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x20B80, 0x2003E, 0x30000, 0x30000, 0x30000,
+    0x2001D, 0x30000, 0x30000, 0x30000, 0x30000, 0x10004, 0x2000C, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x2E800, 0x30000,
+    0x30000, 0x30000, 0x27C00, 0x30000, 0x23600, 0x30000, 0x30000, 0x21300,
+    0x30000, 0x2000A, 0x10002, 0x30000, 0x30000, 0x201A0, 0x30000, 0x2001B,
+    0x30000, 0x20001, 0x20780, 0x20038, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x10000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x20A80,
+    0x1C000, 0x206C0, 0x30000, 0x30000, 0x30000, 0x2000F, 0x20007, 0x30000,
+    0x30000, 0x2002C, 0x21E00, 0x30000, 0x25400, 0x30000, 0x200E0, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x20680, 0x30000,
+    0x30000, 0x100A0, 0x30000, 0x30000, 0x30000, 0x30000, 0x2006C, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x11200, 0x30000, 0x25800, 0x2002A, 0x30000,
+    0x30000, 0x20001, 0x10009, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x2D800, 0x30000, 0x30000, 0x30000, 0x30000, 0x10020,
+    0x10600, 0x30000, 0x30000, 0x10003, 0x30000, 0x30000, 0x24C00, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x10A00, 0x30000, 0x30000, 0x10005, 0x30000, 0x30000, 0x14000,
+    0x20026, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x10060, 0x30000, 0x20002, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x20001, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x20640,
+    0x10000, 0x30000, 0x30000, 0x10008, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x11000, 0x30000, 0x20190, 0x30000, 0x30000,
+    0x30000, 0x202A0, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x10480, 0x30000,
+    0x20000, 0x30000, 0x21C00, 0x30000, 0x30000, 0x30000, 0x202E0, 0x30000,
+    0x30000, 0x204C0, 0x30000, 0x30000, 0x2000E, 0x30000, 0x18800, 0x20006,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x10048, 0x30000, 0x30000, 0x10880,
+    0x30000, 0x20001, 0x201D0, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x10440,
+    0x20260, 0x30000, 0x30000, 0x20003, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x20150, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x10800, 0x200C8, 0x30000, 0x30000, 0x10004, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x10110, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x10044, 0x30000, 0x30000, 0x10088, 0x30000, 0x30000,
+    0x10400, 0x30000, 0x10002, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x20001, 0x30000, 0x30000, 0x19000, 0x30000, 0x30000, 0x10220,
+    0x20000, 0x30000, 0x30000, 0x30000, 0x30000, 0x10900, 0x22C00, 0x30000,
+    0x10050, 0x30000, 0x2B800, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20016, 0x30000, 0x30000, 0x30000, 0x20360, 0x30000, 0x20007, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x20540, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x30000, 0x30000, 0x20320, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x10500, 0x30000, 0x30000, 0x12000,
+    0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x10001, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x10010,
+    0x20000, 0x30000, 0x20580, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x2000B, 0x30000, 0x30000, 0x20003, 0x30000, 0x203A0, 0x2001A, 0x30000,
+    0x30000, 0x10090, 0x30000, 0x30000, 0x23400, 0x30000, 0x2005C, 0x11100,
+    0x1A000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x20000, 0x2001C, 0x30000, 0x30000, 0x20005, 0x30000, 0x200D0, 0x2000D,
+    0x30000, 0x30000, 0x30000, 0x20980, 0x30000, 0x30000, 0x30000, 0x30000,
+    0x30000, 0x30000, 0x10002, 0x30000, 0x30000, 0x205C0, 0x30000, 0x30000,
+    0x30000, 0x20001, 0x203E0, 0x30000, 0x30000, 0x23800, 0x21D00, 0x30000
+};
+
+uint16_t
+rdsparser_sync_checkword(uint16_t info)
+{
+    return rdsparser_sync_table_hi[info >> 8] ^ rdsparser_sync_table_lo[info & 0xFF];
+}
+
+uint16_t
+rdsparser_sync_syndrome(uint32_t block)
+{
+    return rdsparser_sync_checkword((uint16_t)(block >> RDSPARSER_SYNC_CHECK_BITS)) ^
+           (uint16_t)(block & RDSPARSER_SYNC_CHECK_MASK);
+}
+
+rdsparser_block_error_t
+rdsparser_sync_correct(uint32_t  block,
+                       uint16_t  error,
+                       uint16_t *data)
+{
+    const uint32_t burst = rdsparser_sync_table_burst[error];
+    *data = (uint16_t)(block >> RDSPARSER_SYNC_CHECK_BITS) ^ (uint16_t)(burst & RDSPARSER_SYNC_BURST_MASK);
+    return (rdsparser_block_error_t)(burst >> RDSPARSER_SYNC_BURST_LEVEL_SHIFT);
+}
+
+#ifndef RDSPARSER_DISABLE_HEAP
+rdsparser_sync_t*
+rdsparser_sync_new(rdsparser_t *rds)
+{
+    rdsparser_sync_t *sync = malloc(sizeof(rdsparser_sync_t));
+    if (sync)
+    {
+        rdsparser_sync_init(sync, rds);
+    }
+
+    return sync;
+}
+
+void
+rdsparser_sync_free(rdsparser_sync_t *sync)
+{
+    if (sync)
+    {
+        free(sync);
+    }
+}
+#endif
+
+static void
+rdsparser_sync_search_clear(rdsparser_sync_t *sync)
+{
+    for (uint8_t i = 0; i < RDSPARSER_SYNC_BLOCK_BITS; i++)
+    {
+        sync->seen_offset[i] = RDSPARSER_SYNC_OFFSET_NONE;
+    }
+}
+
+void
+rdsparser_sync_init(rdsparser_sync_t *sync,
+                    rdsparser_t      *rds)
+{
+    sync->rds = rds;
+    rdsparser_sync_reset(sync);
+}
+
+void
+rdsparser_sync_reset(rdsparser_sync_t *sync)
+{
+    sync->reg = 0;
+    sync->position = 0;
+    sync->phase = 0;
+    sync->fill = 0;
+    sync->synced = false;
+    sync->bit_count = 0;
+    sync->block = RDSPARSER_BLOCK_A;
+    sync->bad_blocks = 0;
+    sync->groups = 0;
+    sync->corrected = 0;
+    sync->uncorrectable = 0;
+    rdsparser_sync_search_clear(sync);
+}
+
+static void
+rdsparser_sync_acquire(rdsparser_sync_t *sync,
+                       uint8_t           offset)
+{
+    const rdsparser_block_t block = rdsparser_sync_blocks[offset];
+
+    for (uint8_t i = 0; i < RDSPARSER_BLOCK_COUNT; i++)
+    {
+        sync->data[i] = 0;
+        sync->errors[i] = RDSPARSER_BLOCK_ERROR_UNCORRECTABLE;
+    }
+
+    sync->data[block] = (uint16_t)(sync->reg >> RDSPARSER_SYNC_CHECK_BITS);
+    sync->errors[block] = RDSPARSER_BLOCK_ERROR_NONE;
+    sync->block = (block + 1) % RDSPARSER_BLOCK_COUNT;
+    sync->bit_count = 0;
+    sync->bad_blocks = 0;
+    sync->synced = true;
+}
+
+bool
+rdsparser_sync_detect(rdsparser_sync_t *sync,
+                      uint8_t           offset,
+                      uint8_t           phase,
+                      uint32_t          position)
+{
+    const uint8_t previous = sync->seen_offset[phase];
+    const uint32_t distance = (position - sync->seen_position[phase]) / RDSPARSER_SYNC_BLOCK_BITS;
+
+    if (previous != RDSPARSER_SYNC_OFFSET_NONE &&
+        distance <= RDSPARSER_SYNC_SEARCH_BLOCKS &&
+        (rdsparser_sync_blocks[previous] + distance) % RDSPARSER_BLOCK_COUNT == rdsparser_sync_blocks[offset])
+    {
+        rdsparser_sync_acquire(sync, offset);
+        return true;
+    }
+
+    sync->seen_offset[phase] = offset;
+    sync->seen_position[phase] = position;
+    return false;
+}
+
+static void
+rdsparser_sync_search(rdsparser_sync_t *sync)
+{
+    const uint8_t phase = sync->phase;
+    sync->phase = (uint8_t)((phase + 1 == RDSPARSER_SYNC_BLOCK_BITS) ? 0 : phase + 1);
+    sync->position++;
+
+    if (sync->fill < RDSPARSER_SYNC_BLOCK_BITS)
+    {
+        if (++sync->fill < RDSPARSER_SYNC_BLOCK_BITS)
+        {
+            return;
+        }
+    }
+
+    const uint16_t syndrome = rdsparser_sync_syndrome(sync->reg);
+
+    for (uint8_t offset = 0; offset < RDSPARSER_SYNC_COUNT; offset++)
+    {
+        if (syndrome == rdsparser_sync_offsets[offset])
+        {
+            rdsparser_sync_detect(sync, offset, phase, sync->position);
+            return;
+        }
+    }
+}
+
+static rdsparser_block_error_t
+rdsparser_sync_decode(rdsparser_sync_t *sync,
+                      uint16_t         *data)
+{
+    const uint16_t syndrome = rdsparser_sync_syndrome(sync->reg);
+    uint8_t offset = sync->block;
+
+    if (sync->block == RDSPARSER_BLOCK_C)
+    {
+        /* Block C' is expected in version B groups (only
+           an error-free block B gives a reliable version) */
+        const bool version_b = (sync->errors[RDSPARSER_BLOCK_B] == RDSPARSER_BLOCK_ERROR_NONE &&
+                                (sync->data[RDSPARSER_BLOCK_B] & 0x0800));
+        if (syndrome == RDSPARSER_SYNC_OFFSET_CP ||
+            (version_b && syndrome != RDSPARSER_SYNC_OFFSET_C))
+        {
+            offset = RDSPARSER_SYNC_CP;
+        }
+    }
+    else if (sync->block == RDSPARSER_BLOCK_D)
+    {
+        offset = RDSPARSER_SYNC_D;
+    }
+
+    return rdsparser_sync_correct(sync->reg, syndrome ^ rdsparser_sync_offsets[offset], data);
+}
+
+size_t
+rdsparser_sync_block(rdsparser_sync_t *sync)
+{
+    const rdsparser_block_t block = sync->block;
+    size_t emitted = 0;
+    uint16_t data;
+
+    const rdsparser_block_error_t error = rdsparser_sync_decode(sync, &data);
+    sync->data[block] = data;
+    sync->errors[block] = error;
+
+    if (error == RDSPARSER_BLOCK_ERROR_NONE)
+    {
+        sync->bad_blocks = 0;
+    }
+    else
+    {
+        if (error == RDSPARSER_BLOCK_ERROR_UNCORRECTABLE)
+        {
+            sync->uncorrectable++;
+        }
+        else
+        {
+            sync->corrected++;
+        }
+        sync->bad_blocks++;
+    }
+
+    if (block == RDSPARSER_BLOCK_D)
+    {
+        rdsparser_parser_process(sync->rds, sync->data, sync->errors);
+        sync->groups++;
+        emitted = 1;
+    }
+
+    sync->block = (block + 1) % RDSPARSER_BLOCK_COUNT;
+
+    if (sync->bad_blocks >= RDSPARSER_SYNC_LOSS_BLOCKS)
+    {
+        /* The register is already full, search from the next bit */
+        sync->synced = false;
+        rdsparser_sync_search_clear(sync);
+    }
+
+    return emitted;
+}
+
+static inline size_t
+rdsparser_sync_bit(rdsparser_sync_t *sync,
+                   uint8_t           bit)
+{
+    sync->reg = ((sync->reg << 1) | bit) & RDSPARSER_SYNC_BLOCK_MASK;
+
+    if (!sync->synced)
+    {
+        rdsparser_sync_search(sync);
+        return 0;
+    }
+
+    if (++sync->bit_count < RDSPARSER_SYNC_BLOCK_BITS)
+    {
+        return 0;
+    }
+
+    sync->bit_count = 0;
+    return rdsparser_sync_block(sync);
+}
+
+size_t
+rdsparser_sync_feed(rdsparser_sync_t *sync,
+                    const uint8_t    *buffer,
+                    size_t            bits)
+{
+    size_t groups = 0;
+
+    for (size_t i = 0; i < bits; i++)
+    {
+        groups += rdsparser_sync_bit(sync, (buffer[i / 8] >> (7 - i % 8)) & 1);
+    }
+
+    return groups;
+}
+
+size_t
+rdsparser_sync_feed_bits(rdsparser_sync_t *sync,
+                         const uint8_t    *bits,
+                         size_t            count)
+{
+    size_t groups = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        groups += rdsparser_sync_bit(sync, bits[i] & 1);
+    }
+
+    return groups;
+}
+
+bool
+rdsparser_sync_get_synced(const rdsparser_sync_t *sync)
+{
+    return sync->synced;
+}
+
+uint32_t
+rdsparser_sync_get_groups(const rdsparser_sync_t *sync)
+{
+    return sync->groups;
+}
+
+uint32_t
+rdsparser_sync_get_corrected(const rdsparser_sync_t *sync)
+{
+    return sync->corrected;
+}
+
+uint32_t
+rdsparser_sync_get_uncorrectable(const rdsparser_sync_t *sync)
+{
+    return sync->uncorrectable;
+}
@@ -0,0 +1,44 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#ifndef RDSPARSER_SYNC_H
+#define RDSPARSER_SYNC_H
+#include <librdsparser_private.h>
+
+#define RDSPARSER_SYNC_OFFSET_A  0x0FC
+#define RDSPARSER_SYNC_OFFSET_B  0x198
+#define RDSPARSER_SYNC_OFFSET_C  0x168
+#define RDSPARSER_SYNC_OFFSET_CP 0x350
+#define RDSPARSER_SYNC_OFFSET_D  0x1B4
+
+enum rdsparser_sync_offset
+{
+    RDSPARSER_SYNC_A = 0,
+    RDSPARSER_SYNC_B,
+    RDSPARSER_SYNC_C,
+    RDSPARSER_SYNC_CP,
+    RDSPARSER_SYNC_D,
+    RDSPARSER_SYNC_COUNT
+};
+
+uint16_t rdsparser_sync_checkword(uint16_t info);
+uint16_t rdsparser_sync_syndrome(uint32_t block);
+rdsparser_block_error_t rdsparser_sync_correct(uint32_t block, uint16_t error, uint16_t *data);
+bool rdsparser_sync_detect(rdsparser_sync_t *sync, uint8_t offset, uint8_t phase, uint32_t position);
+size_t rdsparser_sync_block(rdsparser_sync_t *sync);
+
+#endif
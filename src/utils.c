@@ -15,64 +15,101 @@
  */
 
 #include <stdint.h>
-#include <string.h>
+#include <stddef.h>
 #include <librdsparser_private.h>
+#include "utils.h"
 
-bool
-rdsparser_utils_convert(const char        *input,
-                        rdsparser_data_t   data_out,
-                        rdsparser_error_t  errors_out)
+#define RDSPARSER_UTILS_BLOCK_LENGTH 4
+#define RDSPARSER_UTILS_ERROR_LENGTH 2
+#define RDSPARSER_UTILS_VALID 0x10
+
+/* Hex digit value with RDSPARSER_UTILS_VALID flag, 0 for other characters */
+static const uint8_t rdsparser_utils_hex[256] =
 {
-    const size_t block_string_length = 4;
-    const size_t error_string_length = 2;
+    ['0'] = 0x10, ['1'] = 0x11, ['2'] = 0x12, ['3'] = 0x13,
+    ['4'] = 0x14, ['5'] = 0x15, ['6'] = 0x16, ['7'] = 0x17,
+    ['8'] = 0x18, ['9'] = 0x19, ['A'] = 0x1A, ['B'] = 0x1B,
+    ['C'] = 0x1C, ['D'] = 0x1D, ['E'] = 0x1E, ['F'] = 0x1F,
+    ['a'] = 0x1A, ['b'] = 0x1B, ['c'] = 0x1C, ['d'] = 0x1D,
+    ['e'] = 0x1E, ['f'] = 0x1F
+};
 
-    const size_t rds_len = RDSPARSER_BLOCK_COUNT * block_string_length;
-    const size_t input_len = strlen(input);
-    char *end;
+static inline uint16_t
+rdsparser_utils_decode(const uint8_t *input,
+                       uint8_t        length,
+                       uint8_t       *valid)
+{
+    uint16_t value = 0;
 
-    if (input_len == rds_len)
+    for (uint8_t i = 0; i < length; i++)
     {
-        errors_out[RDSPARSER_BLOCK_A] = 0;
-        errors_out[RDSPARSER_BLOCK_B] = 0;
-        errors_out[RDSPARSER_BLOCK_C] = 0;
-        errors_out[RDSPARSER_BLOCK_D] = 0;
+        const uint8_t digit = rdsparser_utils_hex[input[i]];
+        *valid &= digit;
+        value = (uint16_t)((value << 4) | (digit & 0x0F));
     }
-    else if (input_len == rds_len + error_string_length)
-    {
-        const char *ptr = input + RDSPARSER_BLOCK_COUNT * block_string_length;
-        uint8_t buffer = (uint8_t)strtol(ptr, &end, 16);
 
-        if (*end != '\0')
-        {
-            return false;
-        }
+    return value;
+}
 
-        errors_out[RDSPARSER_BLOCK_A] = (buffer & 192) >> 6;
-        errors_out[RDSPARSER_BLOCK_B] = (buffer & 48) >> 4;
-        errors_out[RDSPARSER_BLOCK_C] = (buffer & 12) >> 2;
-        errors_out[RDSPARSER_BLOCK_D] = (buffer & 3);
+bool
+rdsparser_utils_convert_n(const char        *input,
+                          size_t             length,
+                          rdsparser_data_t   data_out,
+                          rdsparser_error_t  errors_out)
+{
+    const size_t rds_len = RDSPARSER_BLOCK_COUNT * RDSPARSER_UTILS_BLOCK_LENGTH;
+    const uint8_t *ptr = (const uint8_t*)input;
+    uint8_t valid = RDSPARSER_UTILS_VALID;
+    uint8_t error = 0;
+
+    if (length == rds_len + RDSPARSER_UTILS_ERROR_LENGTH)
+    {
+        error = (uint8_t)rdsparser_utils_decode(ptr + rds_len, RDSPARSER_UTILS_ERROR_LENGTH, &valid);
     }
-    else
+    else if (length != rds_len)
     {
         return false;
     }
 
+    rdsparser_data_t data;
     for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
     {
-        char buffer[block_string_length + 1];
-        for (uint8_t i = 0; i < block_string_length; i++)
-        {
-            buffer[i] = input[block * block_string_length + i];
-        }
+        data[block] = rdsparser_utils_decode(ptr + block * RDSPARSER_UTILS_BLOCK_LENGTH,
+                                             RDSPARSER_UTILS_BLOCK_LENGTH,
+                                             &valid);
+    }
 
-        buffer[block_string_length] = '\0';
-        data_out[block] = (uint16_t)strtol(buffer, &end, 16);
+    if (!valid)
+    {
+        return false;
+    }
 
-        if (*end != '\0')
-        {
-            return false;
-        }
+    for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+    {
+        data_out[block] = data[block];
     }
 
+    errors_out[RDSPARSER_BLOCK_A] = (error & 192) >> 6;
+    errors_out[RDSPARSER_BLOCK_B] = (error & 48) >> 4;
+    errors_out[RDSPARSER_BLOCK_C] = (error & 12) >> 2;
+    errors_out[RDSPARSER_BLOCK_D] = (error & 3);
     return true;
 }
+
+bool
+rdsparser_utils_convert(const char        *input,
+                        rdsparser_data_t   data_out,
+                        rdsparser_error_t  errors_out)
+{
+    const size_t max_len = RDSPARSER_BLOCK_COUNT * RDSPARSER_UTILS_BLOCK_LENGTH + RDSPARSER_UTILS_ERROR_LENGTH;
+    size_t length = 0;
+
+    /* Longer input is invalid anyway, do not scan it */
+    while (length <= max_len &&
+           input[length] != '\0')
+    {
+        length++;
+    }
+
+    return rdsparser_utils_convert_n(input, length, data_out, errors_out);
+}
@@ -16,8 +16,10 @@
 
 #ifndef RDSPARSER_UTILS_H
 #define RDSPARSER_UTILS_H
+#include <stddef.h>
 #include <librdsparser_private.h>
 
 bool rdsparser_utils_convert(const char *input, rdsparser_data_t data_out, rdsparser_error_t errors_out);
+bool rdsparser_utils_convert_n(const char *input, size_t length, rdsparser_data_t data_out, rdsparser_error_t errors_out);
 
 #endif
\ No newline at end of file
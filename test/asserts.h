@@ -1,10 +1,30 @@
 #ifndef RDSPARSER_TEST_ASSERTS_H
 #define RDSPARSER_TEST_ASSERTS_H
 #include <wchar.h>
+#include "string.h"
 
-#ifdef RDSPARSER_DISABLE_UNICODE
-#define assert_rds_string_equal(current, expected) \
+#ifdef RDSPARSER_COMPACT_STRINGS
+/* Raw RDS codes, decoded with the table of the string */
+#define assert_rds_string_equal(string, expected) \
     { \
+        const rdsparser_string_char_t *content = rdsparser_string_get_content(string); \
+        const uint8_t length = rdsparser_string_get_length(string); \
+        wchar_t current[RDSPARSER_RT_LENGTH + 1]; \
+        uint8_t i; \
+        for (i = 0; i < length && content[i] != '\0'; i++) \
+        { \
+            current[i] = (wchar_t)rdsparser_string_decode(string, content[i]); \
+        } \
+        current[i] = L'\0'; \
+        if (wcscmp(current, expected) != 0) \
+        { \
+            fail_msg("\"%ls\" != \"%ls\"", current, expected); \
+        } \
+    }
+#elif defined(RDSPARSER_DISABLE_UNICODE)
+#define assert_rds_string_equal(string, expected) \
+    { \
+        const rdsparser_string_char_t *current = rdsparser_string_get_content(string); \
         size_t length = wcslen(expected); \
         rdsparser_string_char_t *ascii = calloc(length + 1, 1); \
         for (size_t i = 0; i < length; i++) \
@@ -15,11 +35,14 @@
         free(ascii); \
     }
 #else
-#define assert_rds_string_equal(current, expected) \
-    if (wcscmp(current, expected) != 0) \
+#define assert_rds_string_equal(string, expected) \
     { \
-        fail_msg("\"%ls\" != \"%ls\"", current, expected); \
+        const rdsparser_string_char_t *current = rdsparser_string_get_content(string); \
+        if (wcscmp(current, expected) != 0) \
+        { \
+            fail_msg("\"%ls\" != \"%ls\"", current, expected); \
+        } \
     }
 #endif
 
-#endif
\ No newline at end of file
+#endif
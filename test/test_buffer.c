@@ -93,14 +93,30 @@ buffer_test_extended_check(void **state)
     assert_int_equal(rdsparser_buffer_get_extended_check(&ctx->buffer), false);
 }
 
+static void
+buffer_test_voting(void **state)
+{
+    test_context_t *ctx = *state;
+
+    assert_int_equal(rdsparser_buffer_get_voting_threshold(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PI), 0);
+    assert_int_equal(rdsparser_buffer_get_voting_window(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PI), 0);
+    rdsparser_buffer_set_voting(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PI, 6, 4);
+    assert_int_equal(rdsparser_buffer_get_voting_threshold(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PI), 6);
+    assert_int_equal(rdsparser_buffer_get_voting_window(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PI), 4);
+    assert_int_equal(rdsparser_buffer_get_voting_threshold(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PTY), 0);
+    rdsparser_buffer_set_voting(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PI, 0, 4);
+    assert_int_equal(rdsparser_buffer_get_voting_threshold(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PI), 0);
+    assert_int_equal(rdsparser_buffer_get_voting_window(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PI), 0);
+}
+
 static void
 buffer_test_update_pi(void **state)
 {
     test_context_t *ctx = *state;
     
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD), true);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), 0xDEAD);
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_NONE), false);
 }
 
 static void
@@ -109,34 +125,77 @@ buffer_test_update_pi_extended_check(void **state)
     test_context_t *ctx = *state;
     rdsparser_buffer_set_extended_check(&ctx->buffer, true);
 
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), RDSPARSER_PI_UNKNOWN);
 
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD), true);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), 0xDEAD);
 
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD), false);
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xBEEF), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xBEEF, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), 0xDEAD);
 
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xBEEF), true);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xBEEF, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), 0xBEEF);
 
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x1234), false);
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x5677), false);
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x0000), false);
-    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xFFFF), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x1234, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x5677, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x0000, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xFFFF, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), 0xBEEF);
 }
 
+static void
+buffer_test_update_pi_voting(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_buffer_set_voting(&ctx->buffer, RDSPARSER_BUFFER_FIELD_PI, 4, 4);
+
+    /* Uncorrected block alone is not enough */
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), RDSPARSER_PI_UNKNOWN);
+
+    /* Corrected block confirms it */
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_LARGE), true);
+    assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), 0xDEAD);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_NONE), false);
+
+    /* Weight of 1 + 2 does not reach the threshold */
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xBEEF, RDSPARSER_BLOCK_ERROR_LARGE), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xBEEF, RDSPARSER_BLOCK_ERROR_SMALL), false);
+    assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), 0xDEAD);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xBEEF, RDSPARSER_BLOCK_ERROR_LARGE), true);
+    assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), 0xBEEF);
+
+    /* Old observations leave the window */
+    rdsparser_buffer_clear(&ctx->buffer);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x1234, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x5678, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x5678, RDSPARSER_BLOCK_ERROR_SMALL), true);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x0000, RDSPARSER_BLOCK_ERROR_LARGE), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0x1234, RDSPARSER_BLOCK_ERROR_LARGE), false);
+    assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), 0x5678);
+}
+
+static void
+buffer_test_update_pi_corrected(void **state)
+{
+    test_context_t *ctx = *state;
+
+    /* Without the voting, only error-free blocks are used */
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_SMALL), false);
+    assert_int_equal(rdsparser_buffer_update_pi(&ctx->buffer, 0xDEAD, RDSPARSER_BLOCK_ERROR_LARGE), false);
+    assert_int_equal(rdsparser_buffer_get_pi(&ctx->buffer), RDSPARSER_PI_UNKNOWN);
+}
+
 static void
 buffer_test_update_pty(void **state)
 {
     test_context_t *ctx = *state;
     
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 5), true);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 5, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_pty(&ctx->buffer), 5);
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 5), false);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 5, RDSPARSER_BLOCK_ERROR_NONE), false);
 }
 
 static void
@@ -145,23 +204,23 @@ buffer_test_update_pty_extended_check(void **state)
     test_context_t *ctx = *state;
     rdsparser_buffer_set_extended_check(&ctx->buffer, true);
 
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 4), false);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 4, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_pty(&ctx->buffer), RDSPARSER_PTY_UNKNOWN);
 
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 4), true);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 4, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_pty(&ctx->buffer), 4);
 
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 4), false);
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 7), false);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 4, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 7, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_pty(&ctx->buffer), 4);
 
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 7), true);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 7, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_pty(&ctx->buffer), 7);
 
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 8), false);
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 4), false);
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 2), false);
-    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 0), false);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 8, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 4, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 2, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_pty(&ctx->buffer, 0, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_pty(&ctx->buffer), 7);
 }
 
@@ -170,9 +229,9 @@ buffer_test_update_tp(void **state)
 {
     test_context_t *ctx = *state;
     
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON), true);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_tp(&ctx->buffer), RDSPARSER_TP_ON);
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON), false);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
 }
 
 static void
@@ -181,23 +240,23 @@ buffer_test_update_tp_extended_check(void **state)
     test_context_t *ctx = *state;
     rdsparser_buffer_set_extended_check(&ctx->buffer, true);
 
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON), false);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_tp(&ctx->buffer), RDSPARSER_TP_UNKNOWN);
 
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON), true);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_tp(&ctx->buffer), RDSPARSER_TP_ON);
 
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON), false);
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_OFF), false);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_OFF, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_tp(&ctx->buffer), RDSPARSER_TP_ON);
 
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_OFF), true);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_OFF, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_tp(&ctx->buffer), RDSPARSER_TP_OFF);
 
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON), false);
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_OFF), false);
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON), false);
-    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_OFF), false);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_OFF, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_tp(&ctx->buffer, RDSPARSER_TP_OFF, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_tp(&ctx->buffer), RDSPARSER_TP_OFF);
 }
 
@@ -206,9 +265,9 @@ buffer_test_update_ta(void **state)
 {
     test_context_t *ctx = *state;
     
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON), true);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_ta(&ctx->buffer), RDSPARSER_TA_ON);
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON), false);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
 }
 
 static void
@@ -217,23 +276,23 @@ buffer_test_update_ta_extended_check(void **state)
     test_context_t *ctx = *state;
     rdsparser_buffer_set_extended_check(&ctx->buffer, true);
 
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON), false);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_ta(&ctx->buffer), RDSPARSER_TA_UNKNOWN);
 
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON), true);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_ta(&ctx->buffer), RDSPARSER_TA_ON);
 
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON), false);
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_OFF), false);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_OFF, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_ta(&ctx->buffer), RDSPARSER_TA_ON);
 
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_OFF), true);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_OFF, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_ta(&ctx->buffer), RDSPARSER_TA_OFF);
 
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON), false);
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_OFF), false);
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON), false);
-    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_OFF), false);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_OFF, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_ON, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ta(&ctx->buffer, RDSPARSER_TA_OFF, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_ta(&ctx->buffer), RDSPARSER_TA_OFF);
 }
 
@@ -242,9 +301,9 @@ buffer_test_update_ms(void **state)
 {
     test_context_t *ctx = *state;
     
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC), true);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_ms(&ctx->buffer), RDSPARSER_MS_MUSIC);
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC), false);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC, RDSPARSER_BLOCK_ERROR_NONE), false);
 }
 
 static void
@@ -253,23 +312,23 @@ buffer_test_update_ms_extended_check(void **state)
     test_context_t *ctx = *state;
     rdsparser_buffer_set_extended_check(&ctx->buffer, true);
 
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC), false);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_ms(&ctx->buffer), RDSPARSER_MS_UNKNOWN);
 
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC), true);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_ms(&ctx->buffer), RDSPARSER_MS_MUSIC);
 
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC), false);
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_SPEECH), false);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_SPEECH, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_ms(&ctx->buffer), RDSPARSER_MS_MUSIC);
 
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_SPEECH), true);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_SPEECH, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_ms(&ctx->buffer), RDSPARSER_MS_SPEECH);
 
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC), false);
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_SPEECH), false);
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC), false);
-    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_SPEECH), false);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_SPEECH, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_MUSIC, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ms(&ctx->buffer, RDSPARSER_MS_SPEECH, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_ms(&ctx->buffer), RDSPARSER_MS_SPEECH);
 }
 
@@ -278,9 +337,9 @@ buffer_test_update_ecc(void **state)
 {
     test_context_t *ctx = *state;
     
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE2), true);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE2, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_ecc(&ctx->buffer), 0xE2);
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE2), false);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE2, RDSPARSER_BLOCK_ERROR_NONE), false);
 }
 
 static void
@@ -289,23 +348,23 @@ buffer_test_update_ecc_extended_check(void **state)
     test_context_t *ctx = *state;
     rdsparser_buffer_set_extended_check(&ctx->buffer, true);
 
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE3), false);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE3, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_ecc(&ctx->buffer), RDSPARSER_ECC_UNKNOWN);
 
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE3), true);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE3, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_ecc(&ctx->buffer), 0xE3);
 
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE3), false);
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE0), false);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE3, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE0, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_ecc(&ctx->buffer), 0xE3);
 
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE0), true);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE0, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_ecc(&ctx->buffer), 0xE0);
 
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xD0), false);
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xA0), false);
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xA3), false);
-    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE4), false);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xD0, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xA0, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xA3, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_ecc(&ctx->buffer, 0xE4, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_ecc(&ctx->buffer), 0xE0);
 }
 
@@ -314,9 +373,9 @@ buffer_test_update_country(void **state)
 {
     test_context_t *ctx = *state;
     
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND), true);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_country(&ctx->buffer), RDSPARSER_COUNTRY_POLAND);
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND), false);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND, RDSPARSER_BLOCK_ERROR_NONE), false);
 }
 
 static void
@@ -325,23 +384,23 @@ buffer_test_update_country_extended_check(void **state)
     test_context_t *ctx = *state;
     rdsparser_buffer_set_extended_check(&ctx->buffer, true);
 
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND), false);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_country(&ctx->buffer), RDSPARSER_COUNTRY_UNKNOWN);
 
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND), true);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_country(&ctx->buffer), RDSPARSER_COUNTRY_POLAND);
 
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND), false);
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_CZECHIA), false);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_POLAND, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_CZECHIA, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_country(&ctx->buffer), RDSPARSER_COUNTRY_POLAND);
 
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_CZECHIA), true);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_CZECHIA, RDSPARSER_BLOCK_ERROR_NONE), true);
     assert_int_equal(rdsparser_buffer_get_country(&ctx->buffer), RDSPARSER_COUNTRY_CZECHIA);
 
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_SWEDEN), false);
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_FINLAND), false);
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_ESTONIA), false);
-    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_LATVIA), false);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_SWEDEN, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_FINLAND, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_ESTONIA, RDSPARSER_BLOCK_ERROR_NONE), false);
+    assert_int_equal(rdsparser_buffer_update_country(&ctx->buffer, RDSPARSER_COUNTRY_LATVIA, RDSPARSER_BLOCK_ERROR_NONE), false);
     assert_int_equal(rdsparser_buffer_get_country(&ctx->buffer), RDSPARSER_COUNTRY_CZECHIA);
 }
 
@@ -395,8 +454,11 @@ const struct CMUnitTest tests[] =
 {
     cmocka_unit_test_setup_teardown(buffer_test_clear, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(buffer_test_extended_check, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(buffer_test_voting, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(buffer_test_update_pi, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(buffer_test_update_pi_extended_check, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(buffer_test_update_pi_voting, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(buffer_test_update_pi_corrected, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(buffer_test_update_pty, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(buffer_test_update_pty_extended_check, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(buffer_test_update_tp, test_setup, test_teardown),
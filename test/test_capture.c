@@ -0,0 +1,173 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "capture.c"
+
+#define TEST_CAPTURE_PATH "test_capture.bin"
+
+static const rdsparser_data_t capture_test_data[] =
+{
+    { 0x1234, 0x5678, 0x9ABC, 0xDEF0 },
+    { 0xA201, 0x2002, 0x20D7, 0x313A },
+    { 0x3566, 0x1000, 0x00E2, 0x0000 }
+};
+
+static const rdsparser_error_t capture_test_errors[] =
+{
+    { 0, 0, 0, 0 },
+    { 0, 1, 2, 3 },
+    { 3, 2, 1, 0 }
+};
+
+#define TEST_CAPTURE_COUNT (sizeof(capture_test_data) / sizeof(capture_test_data[0]))
+
+static size_t
+capture_test_build(uint8_t *output,
+                   uint8_t  flags)
+{
+    size_t length = rdsparser_capture_write_header(output, flags);
+    for (size_t i = 0; i < TEST_CAPTURE_COUNT; i++)
+    {
+        length += rdsparser_capture_write_record(output + length, flags,
+                                                 capture_test_data[i],
+                                                 capture_test_errors[i],
+                                                 (uint16_t)(1000 + i));
+    }
+    return length;
+}
+
+static void
+capture_test_record(void **state)
+{
+    (void)state;
+    uint8_t output[RDSPARSER_CAPTURE_RECORD_SIZE];
+    const uint8_t expected[] = { 0xA2, 0x01, 0x20, 0x02, 0x20, 0xD7, 0x31, 0x3A, 0x1B };
+
+    assert_int_equal(rdsparser_capture_write_record(output, 0, capture_test_data[1], capture_test_errors[1], 0), sizeof(expected));
+    assert_memory_equal(output, expected, sizeof(expected));
+}
+
+static void
+capture_test_roundtrip(void **state)
+{
+    (void)state;
+    uint8_t buffer[RDSPARSER_CAPTURE_HEADER_SIZE + TEST_CAPTURE_COUNT * (RDSPARSER_CAPTURE_RECORD_SIZE + RDSPARSER_CAPTURE_DELTA_SIZE)];
+    const uint8_t flags[] = { 0, RDSPARSER_CAPTURE_FLAG_DELTA };
+
+    for (size_t f = 0; f < sizeof(flags); f++)
+    {
+        rdsparser_capture_t capture;
+        rdsparser_data_t data;
+        rdsparser_error_t errors;
+        uint16_t delta;
+        size_t count = 0;
+
+        const size_t length = capture_test_build(buffer, flags[f]);
+        assert_int_equal(length, RDSPARSER_CAPTURE_HEADER_SIZE + TEST_CAPTURE_COUNT * rdsparser_capture_get_record_size(flags[f]));
+        assert_true(rdsparser_capture_open(&capture, buffer, length));
+
+        while (rdsparser_capture_next(&capture, data, errors, &delta))
+        {
+            assert_memory_equal(data, capture_test_data[count], sizeof(rdsparser_data_t));
+            assert_memory_equal(errors, capture_test_errors[count], sizeof(rdsparser_error_t));
+            assert_int_equal(delta, flags[f] ? 1000 + count : 0);
+            count++;
+        }
+
+        assert_int_equal(count, TEST_CAPTURE_COUNT);
+    }
+}
+
+static void
+capture_test_truncated(void **state)
+{
+    (void)state;
+    uint8_t buffer[RDSPARSER_CAPTURE_HEADER_SIZE + TEST_CAPTURE_COUNT * RDSPARSER_CAPTURE_RECORD_SIZE];
+    rdsparser_t rds;
+
+    const size_t length = capture_test_build(buffer, 0);
+
+    rdsparser_init(&rds);
+    assert_int_equal(rdsparser_capture_parse(&rds, buffer, length - 1), TEST_CAPTURE_COUNT - 1);
+    assert_int_equal(rdsparser_get_pi(&rds), 0xA201);
+}
+
+static void
+capture_test_invalid_header(void **state)
+{
+    (void)state;
+    uint8_t buffer[RDSPARSER_CAPTURE_HEADER_SIZE + TEST_CAPTURE_COUNT * RDSPARSER_CAPTURE_RECORD_SIZE];
+    rdsparser_capture_t capture;
+
+    const size_t length = capture_test_build(buffer, 0);
+    assert_false(rdsparser_capture_open(&capture, buffer, RDSPARSER_CAPTURE_HEADER_SIZE - 1));
+    assert_false(rdsparser_capture_open(&capture, NULL, length));
+
+    buffer[4] = RDSPARSER_CAPTURE_VERSION + 1;
+    assert_false(rdsparser_capture_open(&capture, buffer, length));
+
+    buffer[4] = RDSPARSER_CAPTURE_VERSION;
+    buffer[0] = 'X';
+    assert_false(rdsparser_capture_open(&capture, buffer, length));
+}
+
+static void
+capture_test_replay(void **state)
+{
+    (void)state;
+    uint8_t buffer[RDSPARSER_CAPTURE_HEADER_SIZE + TEST_CAPTURE_COUNT * (RDSPARSER_CAPTURE_RECORD_SIZE + RDSPARSER_CAPTURE_DELTA_SIZE)];
+    rdsparser_t rds;
+    size_t count;
+
+    const size_t length = capture_test_build(buffer, RDSPARSER_CAPTURE_FLAG_DELTA);
+    FILE *file = fopen(TEST_CAPTURE_PATH, "wb");
+    assert_non_null(file);
+    assert_int_equal(fwrite(buffer, 1, length, file), length);
+    fclose(file);
+
+    rdsparser_init(&rds);
+    assert_true(rdsparser_capture_replay(&rds, TEST_CAPTURE_PATH, &count));
+    assert_int_equal(count, TEST_CAPTURE_COUNT);
+    assert_int_equal(rdsparser_get_pi(&rds), 0xA201);
+    remove(TEST_CAPTURE_PATH);
+
+    assert_false(rdsparser_capture_replay(&rds, TEST_CAPTURE_PATH, &count));
+    assert_int_equal(count, 0);
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test(capture_test_record),
+    cmocka_unit_test(capture_test_roundtrip),
+    cmocka_unit_test(capture_test_truncated),
+    cmocka_unit_test(capture_test_invalid_header),
+    cmocka_unit_test(capture_test_replay)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,171 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <librdsparser.h>
+
+#define TEST_ENGINE_CHANNELS 13
+#define TEST_ENGINE_THREADS 4
+#define TEST_ENGINE_GROUPS 200
+#define TEST_ENGINE_QUEUE 16
+
+typedef struct {
+    uint32_t count;
+    uint16_t last_pi;
+    bool ordered;
+    bool same_thread;
+    pthread_t thread;
+} test_channel_t;
+
+static void
+callback_pi(rdsparser_t *rds,
+            void        *user_data)
+{
+    test_channel_t *channel = user_data;
+    const uint16_t pi = (uint16_t)rdsparser_get_pi(rds);
+
+    if (channel->count == 0)
+    {
+        channel->thread = pthread_self();
+    }
+    else if (!pthread_equal(channel->thread, pthread_self()))
+    {
+        channel->same_thread = false;
+    }
+
+    if (channel->count && pi != channel->last_pi + 1)
+    {
+        channel->ordered = false;
+    }
+
+    channel->last_pi = pi;
+    channel->count++;
+}
+
+static rdsparser_engine_t*
+engine_test_setup(test_channel_t *channels)
+{
+    rdsparser_engine_t *engine = rdsparser_engine_new(TEST_ENGINE_CHANNELS, TEST_ENGINE_THREADS, TEST_ENGINE_QUEUE);
+    assert_non_null(engine);
+
+    for (uint32_t i = 0; i < TEST_ENGINE_CHANNELS; i++)
+    {
+        rdsparser_t *rds = rdsparser_engine_get_channel(engine, i);
+        channels[i].count = 0;
+        channels[i].ordered = true;
+        channels[i].same_thread = true;
+        rdsparser_set_user_data(rds, &channels[i]);
+        rdsparser_register_pi(rds, callback_pi);
+    }
+
+    assert_null(rdsparser_engine_get_channel(engine, TEST_ENGINE_CHANNELS));
+    return engine;
+}
+
+static void
+engine_test_check(const test_channel_t *channels)
+{
+    for (uint32_t i = 0; i < TEST_ENGINE_CHANNELS; i++)
+    {
+        assert_int_equal(channels[i].count, TEST_ENGINE_GROUPS);
+        assert_true(channels[i].ordered);
+        assert_true(channels[i].same_thread);
+    }
+}
+
+static void
+engine_test_push(void **state)
+{
+    (void)state;
+    test_channel_t channels[TEST_ENGINE_CHANNELS];
+    rdsparser_engine_t *engine = engine_test_setup(channels);
+    const rdsparser_error_t errors = { 0 };
+
+    rdsparser_data_t data = { 0x1000, 0x0400, 0x0000, 0x2020 };
+    assert_false(rdsparser_engine_push(engine, 0, data, errors));
+    assert_true(rdsparser_engine_start(engine, true));
+    assert_false(rdsparser_engine_start(engine, true));
+
+    for (uint32_t g = 0; g < TEST_ENGINE_GROUPS; g++)
+    {
+        for (uint32_t i = 0; i < TEST_ENGINE_CHANNELS; i++)
+        {
+            data[RDSPARSER_BLOCK_A] = (uint16_t)(0x1000 * i + g);
+            assert_true(rdsparser_engine_push(engine, i, data, errors));
+        }
+    }
+
+    assert_false(rdsparser_engine_push(engine, TEST_ENGINE_CHANNELS, data, errors));
+
+    rdsparser_engine_flush(engine);
+    engine_test_check(channels);
+    rdsparser_engine_free(engine);
+}
+
+static void
+engine_test_push_batch(void **state)
+{
+    (void)state;
+    test_channel_t channels[TEST_ENGINE_CHANNELS];
+    rdsparser_engine_t *engine = engine_test_setup(channels);
+    const size_t count = TEST_ENGINE_CHANNELS * TEST_ENGINE_GROUPS;
+    rdsparser_data_t *data = calloc(count, sizeof(rdsparser_data_t));
+    rdsparser_error_t *errors = calloc(count, sizeof(rdsparser_error_t));
+    uint32_t *ids = calloc(count, sizeof(uint32_t));
+
+    for (uint32_t g = 0; g < TEST_ENGINE_GROUPS; g++)
+    {
+        for (uint32_t i = 0; i < TEST_ENGINE_CHANNELS; i++)
+        {
+            const size_t index = g * TEST_ENGINE_CHANNELS + i;
+            ids[index] = i;
+            data[index][RDSPARSER_BLOCK_A] = (uint16_t)(0x1000 * i + g);
+        }
+    }
+
+    assert_true(rdsparser_engine_start(engine, false));
+    assert_int_equal(rdsparser_engine_push_batch(engine, ids, (const rdsparser_data_t*)data, (const rdsparser_error_t*)errors, count), count);
+
+    /* Stop drains the queues */
+    rdsparser_engine_stop(engine);
+    engine_test_check(channels);
+    assert_int_equal(rdsparser_engine_get_worker(engine, 5), 5 % TEST_ENGINE_THREADS);
+
+    rdsparser_engine_free(engine);
+    free(data);
+    free(errors);
+    free(ids);
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test(engine_test_push),
+    cmocka_unit_test(engine_test_push_batch)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,278 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "event.c"
+
+#define TEST_EVENT_CAPACITY 8
+
+typedef struct {
+    rdsparser_t rds;
+    rdsparser_event_queue_t queue;
+    rdsparser_event_t events[TEST_EVENT_CAPACITY];
+} test_context_t;
+
+static int
+group_setup(void **state)
+{
+    test_context_t *ctx = calloc(sizeof(test_context_t), 1);
+    *state = ctx;
+    return 0;
+}
+
+static int
+group_teardown(void **state)
+{
+    test_context_t *ctx = *state;
+    free(ctx);
+    return 0;
+}
+
+static int
+test_setup(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_init(&ctx->rds);
+    assert_true(rdsparser_event_queue_init(&ctx->queue, ctx->events, TEST_EVENT_CAPACITY));
+    rdsparser_attach_events(&ctx->rds, &ctx->queue);
+    return 0;
+}
+
+static void
+event_test_init(void **state)
+{
+    test_context_t *ctx = *state;
+
+    assert_false(rdsparser_event_queue_init(&ctx->queue, NULL, TEST_EVENT_CAPACITY));
+    assert_false(rdsparser_event_queue_init(&ctx->queue, ctx->events, 0));
+    assert_false(rdsparser_event_queue_init(&ctx->queue, ctx->events, TEST_EVENT_CAPACITY - 1));
+    assert_true(rdsparser_event_queue_init(&ctx->queue, ctx->events, TEST_EVENT_CAPACITY));
+    assert_int_equal(rdsparser_event_queue_get_count(&ctx->queue), 0);
+    assert_null(rdsparser_event_queue_peek(&ctx->queue, 0));
+}
+
+static void
+event_test_fields(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_event_t *event;
+
+    /* PI, PTY, TP, TA, MS, PS and AF */
+    assert_true(rdsparser_parse_string(&ctx->rds, "34DB051E20202020"));
+    assert_int_equal(rdsparser_event_queue_get_count(&ctx->queue), 7);
+
+    event = rdsparser_event_queue_peek(&ctx->queue, 0);
+    assert_int_equal(rdsparser_event_get_type(event), RDSPARSER_EVENT_PI);
+    assert_int_equal(rdsparser_event_get_value(event), 0x34DB);
+    assert_ptr_equal(rdsparser_event_get_context(event), &ctx->rds);
+    assert_null(rdsparser_event_get_string(event));
+    assert_null(rdsparser_event_get_ct(event));
+
+    event = rdsparser_event_queue_peek(&ctx->queue, 1);
+    assert_int_equal(rdsparser_event_get_type(event), RDSPARSER_EVENT_PTY);
+    assert_int_equal(rdsparser_event_get_value(event), 8);
+
+    event = rdsparser_event_queue_peek(&ctx->queue, 2);
+    assert_int_equal(rdsparser_event_get_type(event), RDSPARSER_EVENT_TP);
+    assert_int_equal(rdsparser_event_get_value(event), 1);
+
+    event = rdsparser_event_queue_peek(&ctx->queue, 3);
+    assert_int_equal(rdsparser_event_get_type(event), RDSPARSER_EVENT_TA);
+    assert_int_equal(rdsparser_event_get_value(event), 1);
+
+    event = rdsparser_event_queue_peek(&ctx->queue, 4);
+    assert_int_equal(rdsparser_event_get_type(event), RDSPARSER_EVENT_MS);
+    assert_int_equal(rdsparser_event_get_value(event), 1);
+
+    event = rdsparser_event_queue_peek(&ctx->queue, 5);
+    assert_int_equal(rdsparser_event_get_type(event), RDSPARSER_EVENT_PS);
+    assert_ptr_not_equal(rdsparser_event_get_string(event), rdsparser_get_ps(&ctx->rds));
+    assert_memory_equal(rdsparser_string_get_content(rdsparser_event_get_string(event)),
+                        rdsparser_string_get_content(rdsparser_get_ps(&ctx->rds)),
+                        RDSPARSER_PS_LENGTH * sizeof(rdsparser_string_char_t));
+
+    event = rdsparser_event_queue_peek(&ctx->queue, 6);
+    assert_int_equal(rdsparser_event_get_type(event), RDSPARSER_EVENT_AF);
+    assert_int_equal(rdsparser_event_get_value(event), 90700);
+
+    assert_null(rdsparser_event_queue_peek(&ctx->queue, 7));
+    rdsparser_event_queue_release(&ctx->queue, 4);
+    assert_int_equal(rdsparser_event_queue_get_count(&ctx->queue), 3);
+    assert_int_equal(rdsparser_event_get_type(rdsparser_event_queue_peek(&ctx->queue, 0)), RDSPARSER_EVENT_MS);
+    rdsparser_event_queue_release(&ctx->queue, 100);
+    assert_int_equal(rdsparser_event_queue_get_count(&ctx->queue), 0);
+}
+
+static void
+event_test_rt(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_event_t *event;
+
+    assert_true(rdsparser_parse_string(&ctx->rds, "34DB255F3420303000"));
+    rdsparser_event_queue_release(&ctx->queue, rdsparser_event_queue_get_count(&ctx->queue) - 1);
+
+    event = rdsparser_event_queue_peek(&ctx->queue, 0);
+    assert_int_equal(rdsparser_event_get_type(event), RDSPARSER_EVENT_RT);
+    assert_int_equal(rdsparser_event_get_value(event), RDSPARSER_RT_FLAG_B);
+    assert_int_equal(rdsparser_string_get_length(rdsparser_event_get_string(event)),
+                     rdsparser_string_get_length(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B)));
+    assert_memory_equal(rdsparser_string_get_content(rdsparser_event_get_string(event)),
+                        rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B)),
+                        RDSPARSER_RT_LENGTH * sizeof(rdsparser_string_char_t));
+
+    /* The queued text is not affected by later updates */
+    assert_true(rdsparser_parse_string(&ctx->rds, "34DB255F4142434400"));
+    assert_int_equal(rdsparser_string_get_content(rdsparser_event_get_string(event))[60], '4');
+    assert_int_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B))[60], 'A');
+}
+
+static void
+event_test_ct(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_event_t *event;
+
+    assert_true(rdsparser_parse_string(&ctx->rds, "3F444541D7500580"));
+    rdsparser_event_queue_release(&ctx->queue, rdsparser_event_queue_get_count(&ctx->queue) - 1);
+
+    event = rdsparser_event_queue_peek(&ctx->queue, 0);
+    assert_int_equal(rdsparser_event_get_type(event), RDSPARSER_EVENT_CT);
+    assert_non_null(rdsparser_event_get_ct(event));
+    assert_int_equal(rdsparser_ct_get_hour(rdsparser_event_get_ct(event)), rdsparser_ct_get_hour(rdsparser_get_ct(&ctx->rds)));
+    assert_int_equal(rdsparser_ct_get_minute(rdsparser_event_get_ct(event)), rdsparser_ct_get_minute(rdsparser_get_ct(&ctx->rds)));
+}
+
+static void
+event_test_overflow(void **state)
+{
+    test_context_t *ctx = *state;
+
+    /* 7 events, then a single PI change each */
+    assert_true(rdsparser_parse_string(&ctx->rds, "34DB051E20202020"));
+    assert_true(rdsparser_parse_string(&ctx->rds, "1234051E20202020"));
+    assert_int_equal(rdsparser_event_queue_get_count(&ctx->queue), TEST_EVENT_CAPACITY);
+    assert_int_equal(rdsparser_event_queue_get_dropped(&ctx->queue), 0);
+
+    /* The parser never waits for the consumer */
+    assert_true(rdsparser_parse_string(&ctx->rds, "5678051E20202020"));
+    assert_int_equal(rdsparser_event_queue_get_count(&ctx->queue), TEST_EVENT_CAPACITY);
+    assert_int_equal(rdsparser_event_queue_get_dropped(&ctx->queue), 1);
+    assert_int_equal(rdsparser_event_get_value(rdsparser_event_queue_peek(&ctx->queue, 7)), 0x1234);
+
+    rdsparser_event_queue_release(&ctx->queue, 1);
+    assert_true(rdsparser_parse_string(&ctx->rds, "9ABC051E20202020"));
+    assert_int_equal(rdsparser_event_get_value(rdsparser_event_queue_peek(&ctx->queue, 7)), 0x9ABC);
+}
+
+static void
+event_test_detach(void **state)
+{
+    test_context_t *ctx = *state;
+
+    rdsparser_attach_events(&ctx->rds, NULL);
+    assert_true(rdsparser_parse_string(&ctx->rds, "34DB051E20202020"));
+    assert_int_equal(rdsparser_event_queue_get_count(&ctx->queue), 0);
+}
+
+static uint32_t callback_count;
+static rdsparser_event_payload_t callback_payload;
+static rdsparser_string_char_t callback_content[RDSPARSER_RT_LENGTH];
+
+static void
+callback_event(rdsparser_t                     *rds,
+               rdsparser_event_type_t           type,
+               const rdsparser_event_payload_t *payload,
+               void                            *user_data)
+{
+    assert_int_equal(type, payload->type);
+    callback_count++;
+    callback_payload = *payload;
+    for (uint8_t i = 0; i < payload->length; i++)
+    {
+        callback_content[i] = payload->content[i];
+    }
+}
+
+static void
+event_test_callback(void **state)
+{
+    test_context_t *ctx = *state;
+
+    callback_count = 0;
+    rdsparser_attach_events(&ctx->rds, NULL);
+    rdsparser_register_event(&ctx->rds, callback_event);
+
+    assert_true(rdsparser_parse_string(&ctx->rds, "34DB051E20202020"));
+    assert_int_equal(callback_count, 7);
+    assert_int_equal(callback_payload.type, RDSPARSER_EVENT_AF);
+    assert_int_equal(callback_payload.value, 90700);
+    assert_null(callback_payload.content);
+
+    rdsparser_set_text_progressive(&ctx->rds, RDSPARSER_TEXT_PTYN, true);
+    assert_true(rdsparser_parse_string(&ctx->rds, "34DBA5505241444900"));
+    assert_int_equal(callback_payload.type, RDSPARSER_EVENT_PTYN);
+    assert_int_equal(callback_payload.length, RDSPARSER_PTYN_LENGTH);
+    assert_ptr_equal(callback_payload.errors, rdsparser_string_get_errors(rdsparser_get_ptyn(&ctx->rds)));
+    assert_int_equal(callback_content[0], 'R');
+    assert_int_equal(callback_content[3], 'I');
+
+    assert_true(rdsparser_parse_string(&ctx->rds, "34DB255F3420303000"));
+    assert_int_equal(callback_payload.type, RDSPARSER_EVENT_RT);
+    assert_int_equal(callback_payload.flag, RDSPARSER_RT_FLAG_B);
+
+    assert_true(rdsparser_parse_string(&ctx->rds, "3F444541D7500580"));
+    assert_int_equal(callback_payload.type, RDSPARSER_EVENT_CT);
+    assert_int_equal(callback_payload.year, rdsparser_ct_get_year(rdsparser_get_ct(&ctx->rds)));
+    assert_int_equal(callback_payload.day, rdsparser_ct_get_day(rdsparser_get_ct(&ctx->rds)));
+    assert_int_equal(callback_payload.offset, rdsparser_ct_get_offset(rdsparser_get_ct(&ctx->rds)));
+
+    /* Callback and queue can be used together */
+    rdsparser_attach_events(&ctx->rds, &ctx->queue);
+    callback_count = 0;
+    assert_true(rdsparser_parse_string(&ctx->rds, "1234051E20202020"));
+    assert_true(callback_count > 0);
+    assert_int_equal(rdsparser_event_queue_get_count(&ctx->queue), callback_count);
+
+    rdsparser_register_event(&ctx->rds, NULL);
+    callback_count = 0;
+    assert_true(rdsparser_parse_string(&ctx->rds, "5678051E20202020"));
+    assert_int_equal(callback_count, 0);
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test(event_test_init),
+    cmocka_unit_test_setup(event_test_fields, test_setup),
+    cmocka_unit_test_setup(event_test_rt, test_setup),
+    cmocka_unit_test_setup(event_test_ct, test_setup),
+    cmocka_unit_test_setup(event_test_overflow, test_setup),
+    cmocka_unit_test_setup(event_test_detach, test_setup),
+    cmocka_unit_test_setup(event_test_callback, test_setup)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, group_setup, group_teardown);
+}
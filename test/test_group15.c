@@ -0,0 +1,88 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "group15.c"
+
+static void
+group15b_test_get_flags(void **state)
+{
+    const uint16_t block = 0xFEB8;
+
+    assert_int_equal(rdsparser_group15b_get_tp(block), 1);
+    assert_int_equal(rdsparser_group15b_get_pty(block), 21);
+    assert_int_equal(rdsparser_group15b_get_ta(block), 1);
+    assert_int_equal(rdsparser_group15b_get_ms(block), 1);
+}
+
+static void
+group15b_test_has_copy(void **state)
+{
+    rdsparser_data_t data = { 0x1234, 0xF810, 0x1234, 0xF800 };
+    rdsparser_error_t errors = { 0, 0, 0, 0 };
+
+    assert_true(rdsparser_group15b_has_copy(data, errors));
+
+    errors[RDSPARSER_BLOCK_D] = RDSPARSER_BLOCK_ERROR_UNCORRECTABLE;
+    assert_false(rdsparser_group15b_has_copy(data, errors));
+
+    /* Not a group 15B */
+    errors[RDSPARSER_BLOCK_D] = RDSPARSER_BLOCK_ERROR_NONE;
+    data[RDSPARSER_BLOCK_D] = 0xF000;
+    assert_false(rdsparser_group15b_has_copy(data, errors));
+}
+
+static void
+group15b_test_check(void **state)
+{
+    rdsparser_data_t data = { 0x1234, 0xF810, 0x1234, 0xF810 };
+    rdsparser_error_t errors = { 0, 0, 0, 0 };
+
+    assert_true(rdsparser_group15_check(data, errors));
+
+    /* Mismatching error-free copies */
+    data[RDSPARSER_BLOCK_D] = 0xF9A0;
+    assert_false(rdsparser_group15_check(data, errors));
+
+    /* Corrected copy */
+    errors[RDSPARSER_BLOCK_D] = RDSPARSER_BLOCK_ERROR_SMALL;
+    assert_true(rdsparser_group15_check(data, errors));
+
+    /* Not a group 15B */
+    errors[RDSPARSER_BLOCK_D] = RDSPARSER_BLOCK_ERROR_NONE;
+    data[RDSPARSER_BLOCK_B] = 0xF010;
+    data[RDSPARSER_BLOCK_D] = 0xF1A0;
+    assert_true(rdsparser_group15_check(data, errors));
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test_setup_teardown(group15b_test_get_flags, NULL, NULL),
+    cmocka_unit_test_setup_teardown(group15b_test_has_copy, NULL, NULL),
+    cmocka_unit_test_setup_teardown(group15b_test_check, NULL, NULL)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
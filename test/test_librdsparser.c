@@ -304,6 +304,309 @@ rdsparser_test_parse_string_long(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234567890123458123456789012345678901234567890"), false);
 }
 
+static void
+rdsparser_test_parse_batch(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_data_t data[] =
+    {
+        { 0x34DB, 0x0548, 0xE0CD, 0x4D41 },
+        { 0x34DB, 0x0549, 0xE0CD, 0x5820 },
+        { 0x34DB, 0x054A, 0xE0CD, 0x464D },
+        { 0x34DB, 0x054F, 0xE0CD, 0x2020 }
+    };
+    const rdsparser_error_t errors[] =
+    {
+        { 0, 0, 0, 0 },
+        { 0, 0, 0, 0 },
+        { 0, 3, 0, 0 },
+        { 0, 0, 0, 0 }
+    };
+
+    rdsparser_register_pi(&ctx->rds, callback_pi);
+    rdsparser_register_ps(&ctx->rds, callback_ps);
+    expect_function_call(callback_pi);
+    expect_function_calls(callback_ps, 3);
+    rdsparser_parse_batch(&ctx->rds, data, errors, 4);
+
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x34DB);
+    const rdsparser_string_char_t *content = rdsparser_string_get_content(rdsparser_get_ps(&ctx->rds));
+    assert_int_equal(content[0], 'M');
+    assert_int_equal(content[3], ' ');
+    assert_int_equal(content[4], ' ');
+}
+
+static void
+rdsparser_test_parse_batch_no_errors(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_data_t data[RDSPARSER_PARSER_BATCH_CHUNK + 1];
+
+    for (size_t i = 0; i < RDSPARSER_PARSER_BATCH_CHUNK + 1; i++)
+    {
+        data[i][RDSPARSER_BLOCK_A] = 0x1234;
+        data[i][RDSPARSER_BLOCK_B] = 0x0400;
+        data[i][RDSPARSER_BLOCK_C] = 0x0000;
+        data[i][RDSPARSER_BLOCK_D] = 0x0000;
+    }
+    data[RDSPARSER_PARSER_BATCH_CHUNK][RDSPARSER_BLOCK_A] = 0x4321;
+
+    rdsparser_register_pi(&ctx->rds, callback_pi);
+    expect_function_calls(callback_pi, 2);
+    rdsparser_parse_batch(&ctx->rds, (const rdsparser_data_t*)data, NULL, RDSPARSER_PARSER_BATCH_CHUNK + 1);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x4321);
+}
+
+static void
+rdsparser_test_convert_strings(void **state)
+{
+    const char *input[] =
+    {
+        "A201200220D7313A00",
+        "A201200220D7313A0",
+        NULL,
+        "A20130100064CD4615"
+    };
+    rdsparser_data_t data[4];
+    rdsparser_error_t errors[4];
+
+    assert_int_equal(rdsparser_convert_strings(input, 4, data, errors), 2);
+    assert_int_equal(data[0][RDSPARSER_BLOCK_B], 0x2002);
+    assert_int_equal(errors[1][RDSPARSER_BLOCK_A], RDSPARSER_BLOCK_ERROR_UNCORRECTABLE);
+    assert_int_equal(errors[1][RDSPARSER_BLOCK_B], RDSPARSER_BLOCK_ERROR_UNCORRECTABLE);
+    assert_int_equal(errors[2][RDSPARSER_BLOCK_D], RDSPARSER_BLOCK_ERROR_UNCORRECTABLE);
+    assert_int_equal(data[3][RDSPARSER_BLOCK_D], 0xCD46);
+    assert_int_equal(errors[3][RDSPARSER_BLOCK_B], RDSPARSER_BLOCK_ERROR_SMALL);
+    assert_int_equal(errors[3][RDSPARSER_BLOCK_D], RDSPARSER_BLOCK_ERROR_SMALL);
+}
+
+#ifndef RDSPARSER_DISABLE_UNICODE
+static void
+rdsparser_test_string_to_wchar(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_data_t data[] =
+    {
+        { 0x34DB, 0x0548, 0xE0CD, 0x4D97 }
+    };
+    wchar_t output[RDSPARSER_PS_LENGTH + 1];
+
+    rdsparser_parse_batch(&ctx->rds, data, NULL, 1);
+    const rdsparser_string_t *ps = rdsparser_get_ps(&ctx->rds);
+    assert_int_equal(rdsparser_string_to_wchar(ps, output, RDSPARSER_PS_LENGTH + 1), RDSPARSER_PS_LENGTH);
+    assert_true(wcscmp(output, L"M\u00f6      ") == 0);
+
+    /* Truncated to the output size */
+    assert_int_equal(rdsparser_string_to_wchar(ps, output, 3), 2);
+    assert_true(wcscmp(output, L"M\u00f6") == 0);
+    assert_int_equal(rdsparser_string_to_wchar(ps, output, 0), 0);
+}
+#endif
+
+static void
+rdsparser_test_string_to_utf8(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_data_t data[] =
+    {
+        { 0x34DB, 0x0548, 0xE0CD, 0x4D97 },
+        { 0x34DB, 0x0549, 0xE0CD, 0x4142 }
+    };
+    char output[3 * RDSPARSER_PS_LENGTH + 1];
+    const rdsparser_string_t *ps = rdsparser_get_ps(&ctx->rds);
+
+    assert_int_equal(rdsparser_string_to_utf8(ps, output, sizeof(output)), RDSPARSER_PS_LENGTH);
+    assert_string_equal(output, "        ");
+
+    rdsparser_parse_batch(&ctx->rds, data, NULL, 1);
+#if defined(RDSPARSER_DISABLE_UNICODE) && !defined(RDSPARSER_COMPACT_STRINGS)
+    assert_int_equal(rdsparser_string_to_utf8(ps, output, sizeof(output)), RDSPARSER_PS_LENGTH);
+    assert_string_equal(output, "M       ");
+#else
+    assert_int_equal(rdsparser_string_to_utf8(ps, output, sizeof(output)), RDSPARSER_PS_LENGTH + 1);
+    assert_string_equal(output, "M\xC3\xB6      ");
+
+    /* Multi-byte characters are not split */
+    assert_int_equal(rdsparser_string_to_utf8(ps, output, 3), 1);
+    assert_string_equal(output, "M");
+    assert_int_equal(rdsparser_string_to_utf8(ps, output, 4), 3);
+    assert_string_equal(output, "M\xC3\xB6");
+#endif
+
+    /* Updated after a change */
+    rdsparser_parse_batch(&ctx->rds, data + 1, NULL, 1);
+    rdsparser_string_to_utf8(ps, output, sizeof(output));
+#if defined(RDSPARSER_DISABLE_UNICODE) && !defined(RDSPARSER_COMPACT_STRINGS)
+    assert_string_equal(output, "M AB    ");
+#else
+    assert_string_equal(output, "M\xC3\xB6" "AB    ");
+#endif
+    assert_int_equal(rdsparser_string_to_utf8(ps, output, 0), 0);
+
+#ifndef RDSPARSER_COMPACT_STRINGS
+    /* The cache is filled by the parser, reading does not modify the string */
+    const rdsparser_string_header_t *header = (const rdsparser_string_header_t*)ps;
+    assert_true(header->utf8_valid);
+    rdsparser_clear(&ctx->rds);
+    assert_false(header->utf8_valid);
+    assert_int_equal(rdsparser_string_to_utf8(ps, output, sizeof(output)), RDSPARSER_PS_LENGTH);
+    assert_string_equal(output, "        ");
+    assert_false(header->utf8_valid);
+#endif
+}
+
+static void
+rdsparser_test_string_table(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_data_t data[] =
+    {
+        { 0x34DB, 0x2540, 0x0E0E, 0x4142 },
+        { 0x34DB, 0x2541, 0x1B6E, 0x0F0F },
+        { 0x34DB, 0x2542, 0x1B6E, 0x4344 }
+    };
+    const rdsparser_error_t errors[] =
+    {
+        { 0, 0, 0, 0 },
+        { 0, 0, 1, 0 },
+        { 0, 0, 0, 0 }
+    };
+    const rdsparser_string_t *rt = rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A);
+
+    assert_int_equal(rdsparser_string_get_table(rt), RDSPARSER_STRING_TABLE_G0);
+    rdsparser_parse_batch(&ctx->rds, data, errors, 1);
+    assert_int_equal(rdsparser_string_get_table(rt), RDSPARSER_STRING_TABLE_G1);
+
+    /* Switching codes do not occupy characters */
+    const rdsparser_string_char_t *content = rdsparser_string_get_content(rt);
+    assert_int_equal(content[0], ' ');
+    assert_int_equal(content[1], ' ');
+    assert_int_equal(content[2], 'A');
+
+    /* Corrected switching is ignored */
+    rdsparser_parse_batch(&ctx->rds, data + 1, errors + 1, 1);
+    assert_int_equal(rdsparser_string_get_table(rt), RDSPARSER_STRING_TABLE_G0);
+    rdsparser_parse_batch(&ctx->rds, data + 2, errors + 2, 1);
+    assert_int_equal(rdsparser_string_get_table(rt), RDSPARSER_STRING_TABLE_G2);
+
+    rdsparser_clear(&ctx->rds);
+    assert_int_equal(rdsparser_string_get_table(rt), RDSPARSER_STRING_TABLE_G0);
+}
+
+static void
+rdsparser_test_string_table_fallback(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_data_t data[] =
+    {
+        { 0x34DB, 0x2540, 0x0E0E, 0xC1E3 },
+        { 0x34DB, 0x2541, 0x1B6E, 0x2020 },
+        { 0x34DB, 0x2542, 0x0F0F, 0x2020 }
+    };
+    const rdsparser_error_t errors[] =
+    {
+        { 0, 0, 0, 0 },
+        { 0, 0, 0, 0 },
+        { 0, 0, 0, 0 }
+    };
+    const rdsparser_string_t *rt = rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A);
+
+#ifndef RDSPARSER_DISABLE_UNICODE
+    char output[3 * RDSPARSER_RT_LENGTH + 1];
+
+    /* G1 and G2 are decoded with the G0 table */
+    rdsparser_parse_batch(&ctx->rds, data, errors, 1);
+    rdsparser_string_to_utf8(rt, output, sizeof(output));
+    assert_memory_equal(output, "  \xC3\x80\xC5\x92 ", 7);
+
+    /* Switching does not convert the received characters */
+    rdsparser_parse_batch(&ctx->rds, data + 1, errors + 1, 1);
+    rdsparser_string_to_utf8(rt, output, sizeof(output));
+    assert_memory_equal(output, "  \xC3\x80\xC5\x92 ", 7);
+
+    rdsparser_parse_batch(&ctx->rds, data + 2, errors + 2, 1);
+    rdsparser_string_to_utf8(rt, output, sizeof(output));
+    assert_memory_equal(output, "  \xC3\x80\xC5\x92 ", 7);
+#else
+    (void)data;
+    (void)errors;
+    (void)rt;
+#endif
+}
+
+static void
+rdsparser_test_string_summary(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_data_t data[] =
+    {
+        { 0x34DB, 0x2540, 0x4142, 0x4344 },
+        { 0x34DB, 0x2541, 0x450D, 0x4647 },
+        { 0x34DB, 0x2541, 0x4546, 0x4748 }
+    };
+    const rdsparser_error_t errors[] =
+    {
+        { 0, 0, 1, 0 },
+        { 0, 0, 0, 0 },
+        { 0, 0, 0, 0 }
+    };
+    const rdsparser_string_t *rt = rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A);
+
+    rdsparser_set_text_correction(&ctx->rds, RDSPARSER_TEXT_RT, RDSPARSER_BLOCK_TYPE_DATA, RDSPARSER_BLOCK_ERROR_SMALL);
+    assert_int_equal(rdsparser_string_get_length(rt), RDSPARSER_RT_LENGTH);
+    assert_int_equal(rdsparser_string_get_available_count(rt), 0);
+    assert_int_equal(rdsparser_string_get_min_error(rt), RDSPARSER_STRING_ERROR_UNCORRECTABLE);
+    assert_int_equal(rdsparser_string_get_max_error(rt), RDSPARSER_STRING_ERROR_UNCORRECTABLE);
+
+    rdsparser_parse_batch(&ctx->rds, data, errors, 1);
+    assert_int_equal(rdsparser_string_get_length(rt), RDSPARSER_RT_LENGTH);
+    assert_int_equal(rdsparser_string_get_available_count(rt), 4);
+    assert_int_equal(rdsparser_string_get_min_error(rt), RDSPARSER_STRING_ERROR_NONE);
+    assert_int_equal(rdsparser_string_get_max_error(rt), RDSPARSER_STRING_ERROR_X_SMALL);
+
+    /* End of the text */
+    rdsparser_parse_batch(&ctx->rds, data + 1, errors + 1, 1);
+    assert_int_equal(rdsparser_string_get_length(rt), 5);
+    assert_int_equal(rdsparser_string_get_available_count(rt), 8);
+
+    /* The end of the text is replaced */
+    rdsparser_parse_batch(&ctx->rds, data + 2, errors + 2, 1);
+    assert_int_equal(rdsparser_string_get_length(rt), RDSPARSER_RT_LENGTH);
+    assert_int_equal(rdsparser_string_get_available_count(rt), 8);
+
+    rdsparser_clear(&ctx->rds);
+    assert_int_equal(rdsparser_string_get_available_count(rt), 0);
+    assert_int_equal(rdsparser_string_get_max_error(rt), RDSPARSER_STRING_ERROR_UNCORRECTABLE);
+}
+
+static void
+rdsparser_test_string_changed(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_data_t data[] =
+    {
+        { 0x34DB, 0x2540, 0x4142, 0x4344 },
+        { 0x34DB, 0x2541, 0x4546, 0x4748 },
+        { 0x34DB, 0x2541, 0x4546, 0x4758 }
+    };
+    const rdsparser_string_t *rt = rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A);
+
+    rdsparser_parse_batch(&ctx->rds, data, NULL, 1);
+    assert_int_equal(rdsparser_string_get_changed(rt), 0x0F);
+    rdsparser_parse_batch(&ctx->rds, data + 1, NULL, 1);
+    assert_int_equal(rdsparser_string_get_changed(rt), 0xF0);
+
+    /* Kept until the next change */
+    rdsparser_parse_batch(&ctx->rds, data + 1, NULL, 1);
+    assert_int_equal(rdsparser_string_get_changed(rt), 0xF0);
+    rdsparser_parse_batch(&ctx->rds, data + 2, NULL, 1);
+    assert_int_equal(rdsparser_string_get_changed(rt), 0x80);
+
+    rdsparser_clear(&ctx->rds);
+    assert_true(rdsparser_string_get_changed(rt) == UINT64_MAX);
+    assert_int_equal(rdsparser_string_get_changed(rdsparser_get_ps(&ctx->rds)), 0xFF);
+}
+
 static void
 test_correction(void                  **state,
                 rdsparser_text_t        text,
@@ -335,6 +638,48 @@ rdsparser_test_extended_check(void **state)
 }
 
 
+static void
+rdsparser_test_voting(void **state)
+{
+    test_context_t *ctx = *state;
+
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->rds, RDSPARSER_FEATURE_PI), 0);
+    assert_int_equal(rdsparser_set_voting(&ctx->rds, RDSPARSER_FEATURE_PI | RDSPARSER_FEATURE_ECC, 6, 4), true);
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->rds, RDSPARSER_FEATURE_PI), 6);
+    assert_int_equal(rdsparser_get_voting_window(&ctx->rds, RDSPARSER_FEATURE_PI), 4);
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->rds, RDSPARSER_FEATURE_ECC), 6);
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->rds, RDSPARSER_FEATURE_PTY), 0);
+
+    /* Unsupported fields and window sizes */
+    assert_int_equal(rdsparser_set_voting(&ctx->rds, 0, 6, 4), false);
+    assert_int_equal(rdsparser_set_voting(&ctx->rds, RDSPARSER_FEATURE_PS, 6, 4), false);
+    assert_int_equal(rdsparser_set_voting(&ctx->rds, RDSPARSER_FEATURE_PI, 6, 0), false);
+    assert_int_equal(rdsparser_set_voting(&ctx->rds, RDSPARSER_FEATURE_PI, 6, RDSPARSER_VOTING_WINDOW_MAX + 1), false);
+    /* Threshold that can never be reached */
+    assert_int_equal(rdsparser_set_voting(&ctx->rds, RDSPARSER_FEATURE_PI, 13, 4), false);
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->rds, RDSPARSER_FEATURE_PI), 6);
+    assert_int_equal(rdsparser_set_voting(&ctx->rds, RDSPARSER_FEATURE_PI, 12, 4), true);
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->rds, RDSPARSER_FEATURE_PS), 0);
+
+    assert_int_equal(rdsparser_set_voting(&ctx->rds, RDSPARSER_VOTING_FEATURES, 0, 0), true);
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->rds, RDSPARSER_FEATURE_PI), 0);
+    assert_int_equal(rdsparser_get_voting_window(&ctx->rds, RDSPARSER_FEATURE_ECC), 0);
+}
+
+
+static void
+rdsparser_test_station_change(void **state)
+{
+    test_context_t *ctx = *state;
+
+    assert_int_equal(rdsparser_get_station_change(&ctx->rds), 0);
+    rdsparser_set_station_change(&ctx->rds, 3);
+    assert_int_equal(rdsparser_get_station_change(&ctx->rds), 3);
+    rdsparser_set_station_change(&ctx->rds, 0);
+    assert_int_equal(rdsparser_get_station_change(&ctx->rds), 0);
+}
+
+
 static void
 rdsparser_test_ps_info_correction(void **state)
 {
@@ -512,6 +857,69 @@ rdsparser_test_register_ct(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "3F444541D7500580"), true);
 }
 
+static void
+rdsparser_test_feature_mask(void **state)
+{
+    test_context_t *ctx = *state;
+    const rdsparser_feature_t mask = RDSPARSER_FEATURE_PI | RDSPARSER_FEATURE_PS | RDSPARSER_FEATURE_RT;
+
+    assert_int_equal(rdsparser_get_feature_mask(&ctx->rds), RDSPARSER_FEATURE_ALL);
+    rdsparser_set_feature_mask(&ctx->rds, mask);
+    assert_int_equal(rdsparser_get_feature_mask(&ctx->rds), mask);
+
+    rdsparser_register_pi(&ctx->rds, callback_pi);
+    rdsparser_register_ta(&ctx->rds, callback_ta);
+    rdsparser_register_af(&ctx->rds, callback_af);
+    rdsparser_register_ps(&ctx->rds, callback_ps);
+    rdsparser_register_ecc(&ctx->rds, callback_ecc);
+
+    /* Only PI and PS are decoded from the group 0A */
+    expect_function_call(callback_pi);
+    expect_function_call(callback_ps);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234007890123458"), true);
+    assert_int_equal(rdsparser_get_pty(&ctx->rds), RDSPARSER_PTY_UNKNOWN);
+    assert_int_equal(rdsparser_get_ta(&ctx->rds), RDSPARSER_TA_UNKNOWN);
+    assert_int_equal(rdsparser_get_af(&ctx->rds)->buffer[0], 0);
+
+    /* The group 1A is skipped entirely */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234100000E20000"), true);
+    assert_int_equal(rdsparser_get_ecc(&ctx->rds), RDSPARSER_ECC_UNKNOWN);
+
+    rdsparser_set_feature_mask(&ctx->rds, RDSPARSER_FEATURE_ALL);
+    expect_function_call(callback_ecc);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234100000E20000"), true);
+}
+
+static void
+rdsparser_test_poll_changes(void **state)
+{
+    test_context_t *ctx = *state;
+
+    assert_int_equal(rdsparser_poll_changes(&ctx->rds), 0);
+    assert_null(rdsparser_get_ct(&ctx->rds));
+
+    /* Group 0A: PI, PTY, TP, TA, MS, AF and PS */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234007890123458"), true);
+    assert_int_equal(rdsparser_poll_changes(&ctx->rds),
+                     RDSPARSER_CHANGE_PI | RDSPARSER_CHANGE_PTY | RDSPARSER_CHANGE_TP |
+                     RDSPARSER_CHANGE_TA | RDSPARSER_CHANGE_MS | RDSPARSER_CHANGE_AF |
+                     RDSPARSER_CHANGE_PS);
+
+    /* Nothing new */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234007890123458"), true);
+    assert_int_equal(rdsparser_poll_changes(&ctx->rds), 0);
+
+    /* Changes accumulate until polled */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DB255F3420303000"), true);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DB254F3420303000"), true);
+    assert_int_equal(rdsparser_poll_changes(&ctx->rds) & (RDSPARSER_CHANGE_PI | RDSPARSER_CHANGE_RT_A | RDSPARSER_CHANGE_RT_B),
+                     RDSPARSER_CHANGE_PI | RDSPARSER_CHANGE_RT_A | RDSPARSER_CHANGE_RT_B);
+
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "3F444541D7500580"), true);
+    assert_true(rdsparser_poll_changes(&ctx->rds) & RDSPARSER_CHANGE_CT);
+    assert_non_null(rdsparser_get_ct(&ctx->rds));
+}
+
 const struct CMUnitTest tests[] =
 {
     cmocka_unit_test_setup_teardown(rdsparser_test_reset, test_setup, test_teardown),
@@ -521,7 +929,20 @@ const struct CMUnitTest tests[] =
     cmocka_unit_test_setup_teardown(rdsparser_test_parse_string_invalid, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(rdsparser_test_parse_string_short, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(rdsparser_test_parse_string_long, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_parse_batch, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_parse_batch_no_errors, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_convert_strings, test_setup, test_teardown),
+#ifndef RDSPARSER_DISABLE_UNICODE
+    cmocka_unit_test_setup_teardown(rdsparser_test_string_to_wchar, test_setup, test_teardown),
+#endif
+    cmocka_unit_test_setup_teardown(rdsparser_test_string_to_utf8, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_string_table, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_string_table_fallback, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_string_summary, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_string_changed, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(rdsparser_test_extended_check, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_voting, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_station_change, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(rdsparser_test_ps_info_correction, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(rdsparser_test_ps_data_correction, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(rdsparser_test_rt_info_correction, test_setup, test_teardown),
@@ -542,7 +963,9 @@ const struct CMUnitTest tests[] =
     cmocka_unit_test_setup_teardown(rdsparser_test_register_ps, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(rdsparser_test_register_rt, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(rdsparser_test_register_ptyn, test_setup, test_teardown),
-    cmocka_unit_test_setup_teardown(rdsparser_test_register_ct, test_setup, test_teardown)
+    cmocka_unit_test_setup_teardown(rdsparser_test_register_ct, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_feature_mask, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(rdsparser_test_poll_changes, test_setup, test_teardown)
 };
 
 int
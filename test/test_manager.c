@@ -0,0 +1,259 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "manager.c"
+
+#define TEST_MANAGER_CAPACITY 8
+#define TEST_MANAGER_TABLE_SIZE 16
+
+typedef struct {
+    rdsparser_manager_t manager;
+    rdsparser_manager_station_t stations[TEST_MANAGER_CAPACITY];
+    uint32_t table[TEST_MANAGER_TABLE_SIZE];
+} test_context_t;
+
+static void
+callback_new(rdsparser_t *rds,
+             uint16_t     pi,
+             void        *user_data)
+{
+    function_called();
+    (*(uint32_t*)user_data)++;
+}
+
+static void
+manager_test_group(rdsparser_data_t  data,
+                   rdsparser_error_t errors,
+                   uint16_t          pi,
+                   uint16_t          b)
+{
+    data[RDSPARSER_BLOCK_A] = pi;
+    data[RDSPARSER_BLOCK_B] = b;
+    data[RDSPARSER_BLOCK_C] = pi;
+    data[RDSPARSER_BLOCK_D] = 0x2020;
+
+    for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+    {
+        errors[block] = RDSPARSER_BLOCK_ERROR_NONE;
+    }
+}
+
+static int
+group_setup(void **state)
+{
+    test_context_t *ctx = calloc(sizeof(test_context_t), 1);
+    *state = ctx;
+    return 0;
+}
+
+static int
+group_teardown(void **state)
+{
+    test_context_t *ctx = *state;
+    free(ctx);
+    return 0;
+}
+
+static int
+test_setup(void **state)
+{
+    test_context_t *ctx = *state;
+    assert_true(rdsparser_manager_init(&ctx->manager, ctx->stations, TEST_MANAGER_CAPACITY, ctx->table, TEST_MANAGER_TABLE_SIZE));
+    return 0;
+}
+
+static void
+manager_test_init(void **state)
+{
+    test_context_t *ctx = *state;
+
+    assert_false(rdsparser_manager_init(&ctx->manager, ctx->stations, 0, ctx->table, TEST_MANAGER_TABLE_SIZE));
+    assert_false(rdsparser_manager_init(&ctx->manager, ctx->stations, TEST_MANAGER_CAPACITY, ctx->table, TEST_MANAGER_CAPACITY));
+    assert_false(rdsparser_manager_init(&ctx->manager, ctx->stations, TEST_MANAGER_CAPACITY, ctx->table, TEST_MANAGER_TABLE_SIZE - 1));
+    assert_true(rdsparser_manager_init(&ctx->manager, ctx->stations, TEST_MANAGER_CAPACITY, ctx->table, TEST_MANAGER_TABLE_SIZE));
+}
+
+static void
+manager_test_route(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+    uint32_t created = 0;
+
+    rdsparser_manager_set_user_data(&ctx->manager, &created);
+    rdsparser_manager_register_new(&ctx->manager, callback_new);
+    expect_function_calls(callback_new, 2);
+
+    manager_test_group(data, errors, 0x3566, 0x0400);
+    rdsparser_t *first = rdsparser_manager_parse(&ctx->manager, data, errors);
+    assert_non_null(first);
+    assert_int_equal(rdsparser_get_pi(first), 0x3566);
+
+    manager_test_group(data, errors, 0xA201, 0x0400);
+    rdsparser_t *second = rdsparser_manager_parse(&ctx->manager, data, errors);
+    assert_ptr_not_equal(first, second);
+    assert_int_equal(rdsparser_get_pi(second), 0xA201);
+
+    /* Known station */
+    manager_test_group(data, errors, 0x3566, 0x0401);
+    assert_ptr_equal(rdsparser_manager_parse(&ctx->manager, data, errors), first);
+
+    /* Uncorrectable block A, PI from block C' */
+    manager_test_group(data, errors, 0xA201, 0x0C00);
+    errors[RDSPARSER_BLOCK_A] = RDSPARSER_BLOCK_ERROR_UNCORRECTABLE;
+    assert_ptr_equal(rdsparser_manager_parse(&ctx->manager, data, errors), second);
+
+    /* No reliable PI, the last station is used */
+    manager_test_group(data, errors, 0x3566, 0x0400);
+    errors[RDSPARSER_BLOCK_A] = RDSPARSER_BLOCK_ERROR_UNCORRECTABLE;
+    assert_ptr_equal(rdsparser_manager_parse(&ctx->manager, data, errors), second);
+
+    assert_int_equal(created, 2);
+    assert_int_equal(rdsparser_manager_get_count(&ctx->manager), 2);
+    assert_ptr_equal(rdsparser_manager_find(&ctx->manager, 0x3566), first);
+    assert_ptr_equal(rdsparser_manager_find(&ctx->manager, 0xA201), second);
+    assert_null(rdsparser_manager_find(&ctx->manager, 0x1234));
+}
+
+static void
+manager_test_full(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    for (uint16_t i = 0; i < TEST_MANAGER_CAPACITY; i++)
+    {
+        manager_test_group(data, errors, (uint16_t)(0x1000 + i), 0x0400);
+        assert_ptr_equal(rdsparser_manager_parse(&ctx->manager, data, errors), rdsparser_manager_get(&ctx->manager, i));
+    }
+
+    manager_test_group(data, errors, 0x2000, 0x0400);
+    assert_null(rdsparser_manager_parse(&ctx->manager, data, errors));
+    assert_int_equal(rdsparser_manager_get_count(&ctx->manager), TEST_MANAGER_CAPACITY);
+    assert_null(rdsparser_manager_get(&ctx->manager, TEST_MANAGER_CAPACITY));
+}
+
+static void
+manager_test_noise(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    manager_test_group(data, errors, 0x3566, 0x0400);
+    rdsparser_t *known = rdsparser_manager_parse(&ctx->manager, data, errors);
+    assert_non_null(known);
+
+    /* Corrected PIs never take a slot of the pool */
+    for (uint16_t i = 0; i < 4 * TEST_MANAGER_CAPACITY; i++)
+    {
+        manager_test_group(data, errors, (uint16_t)(0x1000 + i), 0x0400);
+        errors[RDSPARSER_BLOCK_A] = RDSPARSER_BLOCK_ERROR_SMALL;
+        assert_null(rdsparser_manager_parse(&ctx->manager, data, errors));
+    }
+    assert_int_equal(rdsparser_manager_get_count(&ctx->manager), 1);
+
+    /* But they are routed to existing stations */
+    manager_test_group(data, errors, 0x3566, 0x0401);
+    errors[RDSPARSER_BLOCK_A] = RDSPARSER_BLOCK_ERROR_SMALL;
+    assert_ptr_equal(rdsparser_manager_parse(&ctx->manager, data, errors), known);
+
+    /* A real new station is still created */
+    manager_test_group(data, errors, 0xA201, 0x0400);
+    assert_non_null(rdsparser_manager_parse(&ctx->manager, data, errors));
+    assert_int_equal(rdsparser_manager_get_count(&ctx->manager), 2);
+}
+
+static void
+manager_test_remove(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    /* Collect PI codes sharing the same hash to force probing */
+    uint16_t pi[TEST_MANAGER_CAPACITY];
+    uint8_t count = 0;
+    for (uint32_t value = 1; value <= 0xFFFF && count < 4; value++)
+    {
+        if (rdsparser_manager_hash(&ctx->manager, (uint16_t)value) == 3)
+        {
+            pi[count++] = (uint16_t)value;
+        }
+    }
+    pi[count++] = 0x3566;
+    pi[count++] = 0xA201;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        manager_test_group(data, errors, pi[i], 0x0400);
+        rdsparser_manager_parse(&ctx->manager, data, errors);
+    }
+
+    assert_true(rdsparser_manager_remove(&ctx->manager, pi[1]));
+    assert_false(rdsparser_manager_remove(&ctx->manager, pi[1]));
+    assert_true(rdsparser_manager_remove(&ctx->manager, pi[0]));
+    assert_int_equal(rdsparser_manager_get_count(&ctx->manager), count - 2);
+
+    for (uint8_t i = 2; i < count; i++)
+    {
+        rdsparser_t *rds = rdsparser_manager_find(&ctx->manager, pi[i]);
+        assert_non_null(rds);
+        assert_int_equal(rdsparser_get_pi(rds), pi[i]);
+    }
+
+    /* Dense iteration covers the remaining stations */
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < rdsparser_manager_get_count(&ctx->manager); i++)
+    {
+        sum += (uint32_t)rdsparser_get_pi(rdsparser_manager_get(&ctx->manager, i));
+    }
+    assert_int_equal(sum, (uint32_t)pi[2] + pi[3] + pi[4] + pi[5]);
+
+    /* The last station was moved, groups without PI still reach it */
+    manager_test_group(data, errors, 0, 0x0400);
+    errors[RDSPARSER_BLOCK_A] = RDSPARSER_BLOCK_ERROR_UNCORRECTABLE;
+    assert_ptr_equal(rdsparser_manager_parse(&ctx->manager, data, errors), rdsparser_manager_find(&ctx->manager, 0xA201));
+
+    rdsparser_manager_clear(&ctx->manager);
+    assert_int_equal(rdsparser_manager_get_count(&ctx->manager), 0);
+    assert_null(rdsparser_manager_parse(&ctx->manager, data, errors));
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test(manager_test_init),
+    cmocka_unit_test_setup(manager_test_route, test_setup),
+    cmocka_unit_test_setup(manager_test_full, test_setup),
+    cmocka_unit_test_setup(manager_test_noise, test_setup),
+    cmocka_unit_test_setup(manager_test_remove, test_setup)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, group_setup, group_teardown);
+}
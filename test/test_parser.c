@@ -59,13 +59,202 @@ parser_test_get_flag_b(void **state)
     assert_int_equal(rdsparser_parser_get_flag(data), RDSPARSER_GROUP_FLAG_B);
 }
 
+static void
+parser_test_classify_0b(void **state)
+{
+    rdsparser_data_t data;
+    rdsparser_error_t errors = { 3, 0, 3, 3 };
+    data[1] = 0x0800;
+
+    assert_int_equal(rdsparser_parser_classify(data, errors), (0 << 1) | RDSPARSER_GROUP_FLAG_B);
+}
+
+static void
+parser_test_classify_15a(void **state)
+{
+    rdsparser_data_t data;
+    rdsparser_error_t errors = { 0, 2, 0, 0 };
+    data[1] = 0xF000;
+
+    assert_int_equal(rdsparser_parser_classify(data, errors), (15 << 1) | RDSPARSER_GROUP_FLAG_A);
+}
+
+static void
+parser_test_classify_unknown(void **state)
+{
+    rdsparser_data_t data;
+    rdsparser_error_t errors = { 0, 3, 0, 0 };
+    data[1] = 0x2000;
+
+    assert_int_equal(rdsparser_parser_classify(data, errors), RDSPARSER_PARSER_GROUP_UNKNOWN);
+}
+
+static void
+parser_test_handler(rdsparser_t             *rds,
+                    const rdsparser_data_t   data,
+                    const rdsparser_error_t  errors,
+                    void                    *user_data)
+{
+    uint32_t *calls = user_data;
+    (*calls)++;
+}
+
+static void
+parser_test_set_handler(void **state)
+{
+    rdsparser_t rds;
+    rdsparser_init(&rds);
+
+    /* Built-in decoders can not be replaced */
+    assert_false(rdsparser_parser_set_handler(&rds, (0 << 1) | RDSPARSER_GROUP_FLAG_A, parser_test_handler));
+    assert_false(rdsparser_parser_set_handler(&rds, (10 << 1) | RDSPARSER_GROUP_FLAG_A, parser_test_handler));
+    assert_false(rdsparser_parser_set_handler(&rds, (15 << 1) | RDSPARSER_GROUP_FLAG_B, parser_test_handler));
+    assert_false(rdsparser_parser_set_handler(&rds, RDSPARSER_GROUP_TYPE_COUNT, parser_test_handler));
+
+    assert_true(rdsparser_parser_set_handler(&rds, (3 << 1) | RDSPARSER_GROUP_FLAG_A, parser_test_handler));
+    assert_true(rds.handler[(3 << 1) | RDSPARSER_GROUP_FLAG_A] == parser_test_handler);
+    assert_true(rdsparser_parser_set_handler(&rds, (3 << 1) | RDSPARSER_GROUP_FLAG_A, NULL));
+    assert_true(rds.handler[(3 << 1) | RDSPARSER_GROUP_FLAG_A] == NULL);
+}
+
+static void
+parser_test_set_handler_all(void **state)
+{
+    rdsparser_t rds;
+    rdsparser_init(&rds);
+
+    /* Every type without a built-in decoder can have a handler */
+    for (uint8_t type = 0; type < RDSPARSER_GROUP_TYPE_COUNT; type++)
+    {
+        const bool builtin = (rds.handler[type] != NULL);
+        assert_int_equal(rdsparser_parser_set_handler(&rds, type, parser_test_handler), !builtin);
+        assert_true(rds.handler[type] != NULL);
+        if (!builtin)
+        {
+            assert_true(rds.handler[type] == parser_test_handler);
+        }
+    }
+
+    for (uint8_t type = 0; type < RDSPARSER_GROUP_TYPE_COUNT; type++)
+    {
+        if (rds.handler[type] == parser_test_handler)
+        {
+            assert_true(rdsparser_parser_set_handler(&rds, type, NULL));
+            assert_true(rds.handler[type] == NULL);
+        }
+    }
+}
+
+static void
+parser_test_dispatch_custom(void **state)
+{
+    rdsparser_t rds;
+    uint32_t calls = 0;
+    rdsparser_data_t data = { 0x3566, 0x8000, 0x1234, 0x5678 };
+    rdsparser_error_t errors = { 0, 0, 0, 0 };
+
+    rdsparser_init(&rds);
+    rdsparser_set_user_data(&rds, &calls);
+    assert_true(rdsparser_register_group(&rds, 8, RDSPARSER_GROUP_VERSION_A, parser_test_handler));
+
+    rdsparser_parser_process(&rds, data, errors);
+    assert_int_equal(calls, 1);
+    assert_int_equal(rdsparser_get_pi(&rds), 0x3566);
+
+    /* 8B has no handler */
+    data[RDSPARSER_BLOCK_B] = 0x8800;
+    rdsparser_parser_process(&rds, data, errors);
+    assert_int_equal(calls, 1);
+
+    /* Group type is unknown */
+    data[RDSPARSER_BLOCK_B] = 0x8000;
+    errors[RDSPARSER_BLOCK_B] = RDSPARSER_BLOCK_ERROR_UNCORRECTABLE;
+    rdsparser_parser_process(&rds, data, errors);
+    assert_int_equal(calls, 1);
+
+    assert_false(rdsparser_register_group(&rds, 16, RDSPARSER_GROUP_VERSION_A, parser_test_handler));
+    assert_false(rdsparser_register_group(&rds, 2, RDSPARSER_GROUP_VERSION_B, parser_test_handler));
+}
+
+static void
+parser_test_repeat(void **state)
+{
+    rdsparser_t rds;
+    rdsparser_data_t data = { 0x1234, 0x054C, 0x0120, 0x3A3B };
+    rdsparser_data_t other = { 0x1234, 0x054C, 0x0120, 0x4142 };
+    rdsparser_error_t errors = { 0, 0, 0, 0 };
+
+    rdsparser_init(&rds);
+    rdsparser_set_extended_check(&rds, true);
+
+    /* Confirmed with the second group, not a repeat until then */
+    rdsparser_parser_process(&rds, data, errors);
+    rdsparser_parser_process(&rds, data, errors);
+    assert_int_equal(rdsparser_get_pi(&rds), 0x1234);
+    rdsparser_parser_process(&rds, data, errors);
+    assert_int_equal(rdsparser_get_repeat_hits(&rds), 0);
+
+    rdsparser_parser_process(&rds, data, errors);
+    rdsparser_parser_process(&rds, data, errors);
+    assert_int_equal(rdsparser_get_repeat_lookups(&rds), 5);
+    assert_int_equal(rdsparser_get_repeat_hits(&rds), 2);
+
+    /* Different errors do not match */
+    errors[RDSPARSER_BLOCK_D] = RDSPARSER_BLOCK_ERROR_SMALL;
+    rdsparser_parser_process(&rds, data, errors);
+    assert_int_equal(rdsparser_get_repeat_hits(&rds), 2);
+    errors[RDSPARSER_BLOCK_D] = RDSPARSER_BLOCK_ERROR_NONE;
+
+    /* Any change invalidates the cache */
+    rdsparser_parser_process(&rds, other, errors);
+    assert_int_equal(rdsparser_string_get_content(rdsparser_get_ps(&rds))[0], 'A');
+    rdsparser_parser_process(&rds, data, errors);
+    assert_int_equal(rdsparser_string_get_content(rdsparser_get_ps(&rds))[0], ':');
+    assert_int_equal(rdsparser_get_repeat_hits(&rds), 2);
+
+    /* So does a change of the settings */
+    rdsparser_parser_process(&rds, data, errors);
+    rdsparser_set_extended_check(&rds, false);
+    rdsparser_parser_process(&rds, data, errors);
+    assert_int_equal(rdsparser_get_repeat_hits(&rds), 2);
+}
+
+static void
+parser_test_repeat_custom(void **state)
+{
+    rdsparser_t rds;
+    uint32_t calls = 0;
+    rdsparser_data_t data = { 0x3566, 0x8000, 0x1234, 0x5678 };
+    rdsparser_error_t errors = { 0, 0, 0, 0 };
+
+    rdsparser_init(&rds);
+    rdsparser_set_user_data(&rds, &calls);
+    assert_true(rdsparser_register_group(&rds, 8, RDSPARSER_GROUP_VERSION_A, parser_test_handler));
+
+    /* Custom handlers receive all groups */
+    for (int i = 0; i < 4; i++)
+    {
+        rdsparser_parser_process(&rds, data, errors);
+    }
+
+    assert_int_equal(calls, 4);
+    assert_int_equal(rdsparser_get_repeat_hits(&rds), 0);
+}
 
 const struct CMUnitTest tests[] =
 {
     cmocka_unit_test_setup_teardown(parser_test_get_group_2, NULL, NULL),
     cmocka_unit_test_setup_teardown(parser_test_get_group_15, NULL, NULL),
     cmocka_unit_test_setup_teardown(parser_test_get_flag_a, NULL, NULL),
-    cmocka_unit_test_setup_teardown(parser_test_get_flag_b, NULL, NULL)
+    cmocka_unit_test_setup_teardown(parser_test_get_flag_b, NULL, NULL),
+    cmocka_unit_test_setup_teardown(parser_test_classify_0b, NULL, NULL),
+    cmocka_unit_test_setup_teardown(parser_test_classify_15a, NULL, NULL),
+    cmocka_unit_test_setup_teardown(parser_test_classify_unknown, NULL, NULL),
+    cmocka_unit_test_setup_teardown(parser_test_set_handler, NULL, NULL),
+    cmocka_unit_test_setup_teardown(parser_test_set_handler_all, NULL, NULL),
+    cmocka_unit_test_setup_teardown(parser_test_dispatch_custom, NULL, NULL),
+    cmocka_unit_test_setup_teardown(parser_test_repeat, NULL, NULL),
+    cmocka_unit_test_setup_teardown(parser_test_repeat_custom, NULL, NULL)
 };
 
 int
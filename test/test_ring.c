@@ -0,0 +1,272 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#ifndef RDSPARSER_DISABLE_THREADS
+#include <pthread.h>
+#endif
+#include "ring.c"
+
+#define TEST_RING_CAPACITY 8
+#define TEST_RING_THREAD_RECORDS 20000
+
+typedef struct {
+    rdsparser_ring_t ring;
+    rdsparser_ring_record_t records[TEST_RING_CAPACITY];
+} test_context_t;
+
+static void
+ring_test_group(rdsparser_data_t  data,
+                rdsparser_error_t errors,
+                uint32_t          sequence)
+{
+    data[RDSPARSER_BLOCK_A] = 0x3566;
+    data[RDSPARSER_BLOCK_B] = 0x0400;
+    data[RDSPARSER_BLOCK_C] = (uint16_t)(sequence >> 16);
+    data[RDSPARSER_BLOCK_D] = (uint16_t)sequence;
+    errors[RDSPARSER_BLOCK_A] = RDSPARSER_BLOCK_ERROR_NONE;
+    errors[RDSPARSER_BLOCK_B] = RDSPARSER_BLOCK_ERROR_NONE;
+    errors[RDSPARSER_BLOCK_C] = RDSPARSER_BLOCK_ERROR_SMALL;
+    errors[RDSPARSER_BLOCK_D] = (uint8_t)(sequence & 3);
+}
+
+static uint32_t
+ring_test_sequence(const rdsparser_data_t data)
+{
+    return ((uint32_t)data[RDSPARSER_BLOCK_C] << 16) | data[RDSPARSER_BLOCK_D];
+}
+
+static int
+group_setup(void **state)
+{
+    test_context_t *ctx = calloc(sizeof(test_context_t), 1);
+    *state = ctx;
+    return 0;
+}
+
+static int
+group_teardown(void **state)
+{
+    test_context_t *ctx = *state;
+    free(ctx);
+    return 0;
+}
+
+static void
+ring_test_init(void **state)
+{
+    test_context_t *ctx = *state;
+
+    assert_false(rdsparser_ring_init(&ctx->ring, NULL, TEST_RING_CAPACITY, RDSPARSER_RING_POLICY_BLOCK));
+    assert_false(rdsparser_ring_init(&ctx->ring, ctx->records, 0, RDSPARSER_RING_POLICY_BLOCK));
+    assert_false(rdsparser_ring_init(&ctx->ring, ctx->records, TEST_RING_CAPACITY - 1, RDSPARSER_RING_POLICY_BLOCK));
+    assert_false(rdsparser_ring_init(&ctx->ring, ctx->records, TEST_RING_CAPACITY, RDSPARSER_RING_POLICY_BLOCK + 1));
+    assert_true(rdsparser_ring_init(&ctx->ring, ctx->records, TEST_RING_CAPACITY, RDSPARSER_RING_POLICY_BLOCK));
+    assert_int_equal(rdsparser_ring_get_count(&ctx->ring), 0);
+}
+
+static void
+ring_test_fifo(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    assert_true(rdsparser_ring_init(&ctx->ring, ctx->records, TEST_RING_CAPACITY, RDSPARSER_RING_POLICY_DROP_NEWEST));
+    assert_false(rdsparser_ring_pop(&ctx->ring, data, errors));
+
+    /* Wrap around a few times */
+    for (uint32_t i = 0; i < TEST_RING_CAPACITY * 3; i++)
+    {
+        ring_test_group(data, errors, i);
+        assert_true(rdsparser_ring_push(&ctx->ring, data, errors));
+        assert_true(rdsparser_ring_push(&ctx->ring, data, errors));
+        assert_true(rdsparser_ring_pop(&ctx->ring, data, errors));
+        assert_true(rdsparser_ring_pop(&ctx->ring, data, errors));
+        assert_int_equal(ring_test_sequence(data), i);
+        assert_int_equal(errors[RDSPARSER_BLOCK_C], RDSPARSER_BLOCK_ERROR_SMALL);
+        assert_int_equal(errors[RDSPARSER_BLOCK_D], i & 3);
+    }
+
+    assert_int_equal(rdsparser_ring_get_count(&ctx->ring), 0);
+    assert_int_equal(rdsparser_ring_get_dropped(&ctx->ring), 0);
+}
+
+static void
+ring_test_drop_newest(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    assert_true(rdsparser_ring_init(&ctx->ring, ctx->records, TEST_RING_CAPACITY, RDSPARSER_RING_POLICY_DROP_NEWEST));
+
+    for (uint32_t i = 0; i < TEST_RING_CAPACITY + 3; i++)
+    {
+        ring_test_group(data, errors, i);
+        assert_int_equal(rdsparser_ring_push(&ctx->ring, data, errors), i < TEST_RING_CAPACITY);
+    }
+
+    assert_int_equal(rdsparser_ring_get_count(&ctx->ring), TEST_RING_CAPACITY);
+    assert_int_equal(rdsparser_ring_get_dropped(&ctx->ring), 3);
+    assert_true(rdsparser_ring_pop(&ctx->ring, data, errors));
+    assert_int_equal(ring_test_sequence(data), 0);
+}
+
+static void
+ring_test_drop_oldest(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    assert_true(rdsparser_ring_init(&ctx->ring, ctx->records, TEST_RING_CAPACITY, RDSPARSER_RING_POLICY_DROP_OLDEST));
+
+    for (uint32_t i = 0; i < TEST_RING_CAPACITY + 3; i++)
+    {
+        ring_test_group(data, errors, i);
+        assert_int_equal(rdsparser_ring_push(&ctx->ring, data, errors), i < TEST_RING_CAPACITY);
+    }
+
+    assert_int_equal(rdsparser_ring_get_count(&ctx->ring), TEST_RING_CAPACITY);
+    assert_int_equal(rdsparser_ring_get_dropped(&ctx->ring), 3);
+
+    for (uint32_t i = 3; i < TEST_RING_CAPACITY + 3; i++)
+    {
+        assert_true(rdsparser_ring_pop(&ctx->ring, data, errors));
+        assert_int_equal(ring_test_sequence(data), i);
+    }
+    assert_false(rdsparser_ring_pop(&ctx->ring, data, errors));
+}
+
+static void
+ring_test_parse(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+    rdsparser_t rds;
+
+    rdsparser_init(&rds);
+    assert_true(rdsparser_ring_init(&ctx->ring, ctx->records, TEST_RING_CAPACITY, RDSPARSER_RING_POLICY_BLOCK));
+
+    for (uint32_t i = 0; i < TEST_RING_CAPACITY; i++)
+    {
+        ring_test_group(data, errors, i);
+        assert_true(rdsparser_ring_push(&ctx->ring, data, errors));
+    }
+
+    assert_int_equal(rdsparser_ring_parse(&ctx->ring, &rds, 3), 3);
+    assert_int_equal(rdsparser_ring_get_count(&ctx->ring), TEST_RING_CAPACITY - 3);
+    assert_int_equal(rdsparser_get_pi(&rds), 0x3566);
+    assert_int_equal(rdsparser_ring_parse(&ctx->ring, &rds, SIZE_MAX), TEST_RING_CAPACITY - 3);
+    assert_int_equal(rdsparser_ring_parse(&ctx->ring, &rds, SIZE_MAX), 0);
+}
+
+#ifndef RDSPARSER_DISABLE_THREADS
+static void*
+ring_test_producer(void *arg)
+{
+    rdsparser_ring_t *ring = arg;
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    for (uint32_t i = 1; i <= TEST_RING_THREAD_RECORDS; i++)
+    {
+        ring_test_group(data, errors, i);
+        rdsparser_ring_push(ring, data, errors);
+    }
+
+    return NULL;
+}
+
+static void
+ring_test_threads(rdsparser_ring_t        *ring,
+                  rdsparser_ring_policy_t  policy)
+{
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+    uint32_t last = 0;
+    uint32_t received = 0;
+    pthread_t thread;
+
+    rdsparser_ring_record_t *records = malloc(sizeof(rdsparser_ring_record_t) * TEST_RING_CAPACITY);
+    assert_true(rdsparser_ring_init(ring, records, TEST_RING_CAPACITY, policy));
+    assert_int_equal(pthread_create(&thread, NULL, ring_test_producer, ring), 0);
+
+    while (last != TEST_RING_THREAD_RECORDS)
+    {
+        if (rdsparser_ring_pop(ring, data, errors))
+        {
+            const uint32_t sequence = ring_test_sequence(data);
+            /* Records may be dropped, but never reordered or torn */
+            assert_true(sequence > last);
+            assert_int_equal(errors[RDSPARSER_BLOCK_D], sequence & 3);
+            last = sequence;
+            received++;
+        }
+        else
+        {
+            rdsparser_ring_wait();
+        }
+    }
+
+    pthread_join(thread, NULL);
+    assert_int_equal(received + rdsparser_ring_get_dropped(ring), TEST_RING_THREAD_RECORDS);
+    free(records);
+}
+
+static void
+ring_test_threads_block(void **state)
+{
+    test_context_t *ctx = *state;
+    ring_test_threads(&ctx->ring, RDSPARSER_RING_POLICY_BLOCK);
+    assert_int_equal(rdsparser_ring_get_dropped(&ctx->ring), 0);
+}
+
+static void
+ring_test_threads_drop_oldest(void **state)
+{
+    test_context_t *ctx = *state;
+    ring_test_threads(&ctx->ring, RDSPARSER_RING_POLICY_DROP_OLDEST);
+}
+#endif
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test(ring_test_init),
+    cmocka_unit_test(ring_test_fifo),
+    cmocka_unit_test(ring_test_drop_newest),
+    cmocka_unit_test(ring_test_drop_oldest),
+    cmocka_unit_test(ring_test_parse),
+#ifndef RDSPARSER_DISABLE_THREADS
+    cmocka_unit_test(ring_test_threads_block),
+    cmocka_unit_test(ring_test_threads_drop_oldest)
+#endif
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, group_setup, group_teardown);
+}
@@ -0,0 +1,239 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "slice.c"
+
+#define TEST_SLICE_GROUPS 12
+#define TEST_SLICE_GROUP_BITS (RDSPARSER_BLOCK_COUNT * RDSPARSER_SYNC_BLOCK_BITS)
+#define TEST_SLICE_BITS (64 + TEST_SLICE_GROUPS * TEST_SLICE_GROUP_BITS)
+#define TEST_SLICE_BYTES ((TEST_SLICE_BITS + 7) / 8)
+
+typedef struct {
+    rdsparser_slice_t slice;
+    rdsparser_t slice_rds[RDSPARSER_SLICE_LANES];
+    rdsparser_t sync_rds[RDSPARSER_SLICE_LANES];
+    rdsparser_sync_t sync[RDSPARSER_SLICE_LANES];
+    uint8_t streams[RDSPARSER_SLICE_LANES][TEST_SLICE_BYTES];
+} test_context_t;
+
+static void
+slice_test_put(uint8_t  *stream,
+               size_t    position,
+               uint32_t  value,
+               uint8_t   bits)
+{
+    for (uint8_t i = 0; i < bits; i++, position++)
+    {
+        if ((value >> (bits - 1 - i)) & 1)
+        {
+            stream[position / 8] |= (uint8_t)(0x80 >> (position % 8));
+        }
+    }
+}
+
+static void
+slice_test_build(uint8_t *stream,
+                 uint8_t  lane)
+{
+    static const uint16_t offsets[] = { RDSPARSER_SYNC_OFFSET_A, RDSPARSER_SYNC_OFFSET_B, RDSPARSER_SYNC_OFFSET_C, RDSPARSER_SYNC_OFFSET_D };
+    static const char ps[] = "Lane  00";
+    uint32_t seed = lane + 1;
+    size_t position = 0;
+
+    /* Random prefix of different length in each lane */
+    for (; position < (size_t)(lane * 7) % 64; position++)
+    {
+        seed = seed * 1103515245 + 12345;
+        slice_test_put(stream, position, seed >> 31, 1);
+    }
+
+    for (uint8_t g = 0; g < TEST_SLICE_GROUPS; g++)
+    {
+        const uint8_t segment = g % 4;
+        const char c1 = (segment == 3) ? (char)('0' + lane / 10) : ps[segment * 2];
+        const char c2 = (segment == 3) ? (char)('0' + lane % 10) : ps[segment * 2 + 1];
+        const uint16_t group[RDSPARSER_BLOCK_COUNT] =
+        {
+            (uint16_t)(0x1000 + lane),
+            (uint16_t)(0x0400 | segment),
+            0xE20D,
+            (uint16_t)((c1 << 8) | c2)
+        };
+
+        for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+        {
+            const uint32_t word = ((uint32_t)group[block] << 10) | (rdsparser_sync_checkword(group[block]) ^ offsets[block]);
+            slice_test_put(stream, position, word, RDSPARSER_SYNC_BLOCK_BITS);
+            position += RDSPARSER_SYNC_BLOCK_BITS;
+        }
+    }
+
+    /* Errors in some lanes */
+    if (lane % 3 == 0)
+    {
+        stream[20 + lane % 5] ^= 0x10;
+    }
+    if (lane % 5 == 0)
+    {
+        stream[60] ^= 0x81;
+    }
+}
+
+static int
+group_setup(void **state)
+{
+    test_context_t *ctx = calloc(sizeof(test_context_t), 1);
+    *state = ctx;
+    return 0;
+}
+
+static int
+group_teardown(void **state)
+{
+    test_context_t *ctx = *state;
+    free(ctx);
+    return 0;
+}
+
+static int
+test_setup(void **state)
+{
+    test_context_t *ctx = *state;
+
+    rdsparser_slice_init(&ctx->slice);
+    for (uint8_t lane = 0; lane < RDSPARSER_SLICE_LANES; lane++)
+    {
+        rdsparser_init(&ctx->slice_rds[lane]);
+        rdsparser_init(&ctx->sync_rds[lane]);
+        rdsparser_sync_init(&ctx->sync[lane], &ctx->sync_rds[lane]);
+        slice_test_build(ctx->streams[lane], lane);
+    }
+
+    return 0;
+}
+
+static void
+slice_test_syndrome(void **state)
+{
+    test_context_t *ctx = *state;
+    uint64_t words[RDSPARSER_SYNC_BLOCK_BITS * 2] = { 0 };
+
+    rdsparser_slice_attach(&ctx->slice, 5, &ctx->slice_rds[5]);
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++)
+    {
+        words[i] = (uint64_t)((ctx->streams[5][i / 8] >> (7 - i % 8)) & 1) << 5;
+        rdsparser_slice_feed(&ctx->slice, &words[i], 1);
+
+        if (i + 1 >= RDSPARSER_SYNC_BLOCK_BITS)
+        {
+            const uint32_t reg = rdsparser_slice_gather(&ctx->slice, 5);
+            uint16_t syndrome = 0;
+            for (uint8_t j = 0; j < RDSPARSER_SYNC_CHECK_BITS; j++)
+            {
+                syndrome |= (uint16_t)(((ctx->slice.syndrome[j] >> 5) & 1) << j);
+            }
+            assert_int_equal(syndrome, rdsparser_sync_syndrome(reg));
+        }
+    }
+}
+
+static void
+slice_test_lanes(void **state)
+{
+    test_context_t *ctx = *state;
+    const uint8_t *buffers[RDSPARSER_SLICE_LANES];
+    size_t sync_groups = 0;
+
+    for (uint8_t lane = 0; lane < RDSPARSER_SLICE_LANES; lane++)
+    {
+        /* Last lane is left detached */
+        if (lane != RDSPARSER_SLICE_LANES - 1)
+        {
+            rdsparser_slice_attach(&ctx->slice, lane, &ctx->slice_rds[lane]);
+            sync_groups += rdsparser_sync_feed(&ctx->sync[lane], ctx->streams[lane], TEST_SLICE_BITS);
+        }
+        buffers[lane] = ctx->streams[lane];
+    }
+
+    assert_int_equal(rdsparser_slice_feed_lanes(&ctx->slice, buffers, TEST_SLICE_BITS), sync_groups);
+
+    for (uint8_t lane = 0; lane < RDSPARSER_SLICE_LANES - 1; lane++)
+    {
+        const rdsparser_sync_t *sync = rdsparser_slice_get_lane(&ctx->slice, lane);
+        assert_true(rdsparser_sync_get_synced(sync));
+        assert_int_equal(rdsparser_sync_get_groups(sync), rdsparser_sync_get_groups(&ctx->sync[lane]));
+        assert_int_equal(rdsparser_sync_get_corrected(sync), rdsparser_sync_get_corrected(&ctx->sync[lane]));
+        assert_int_equal(rdsparser_sync_get_uncorrectable(sync), rdsparser_sync_get_uncorrectable(&ctx->sync[lane]));
+        assert_int_equal(rdsparser_get_pi(&ctx->slice_rds[lane]), 0x1000 + lane);
+
+        const rdsparser_string_char_t *expected = rdsparser_string_get_content(rdsparser_get_ps(&ctx->sync_rds[lane]));
+        const rdsparser_string_char_t *content = rdsparser_string_get_content(rdsparser_get_ps(&ctx->slice_rds[lane]));
+        for (uint8_t i = 0; i < RDSPARSER_PS_LENGTH; i++)
+        {
+            assert_int_equal(content[i], expected[i]);
+        }
+        assert_int_equal(content[6], '0' + lane / 10);
+        assert_int_equal(content[7], '0' + lane % 10);
+    }
+
+    assert_false(rdsparser_sync_get_synced(rdsparser_slice_get_lane(&ctx->slice, RDSPARSER_SLICE_LANES - 1)));
+    assert_null(rdsparser_slice_get_lane(&ctx->slice, RDSPARSER_SLICE_LANES));
+}
+
+static void
+slice_test_detach(void **state)
+{
+    test_context_t *ctx = *state;
+    const uint8_t *buffers[RDSPARSER_SLICE_LANES] = { NULL };
+
+    buffers[0] = ctx->streams[0];
+    buffers[1] = ctx->streams[1];
+    rdsparser_slice_attach(&ctx->slice, 0, &ctx->slice_rds[0]);
+    rdsparser_slice_attach(&ctx->slice, 1, &ctx->slice_rds[1]);
+
+    rdsparser_slice_feed_lanes(&ctx->slice, buffers, TEST_SLICE_BITS / 2);
+    assert_true(rdsparser_sync_get_synced(rdsparser_slice_get_lane(&ctx->slice, 1)));
+
+    rdsparser_slice_attach(&ctx->slice, 1, NULL);
+    assert_false(rdsparser_sync_get_synced(rdsparser_slice_get_lane(&ctx->slice, 1)));
+    assert_int_equal(ctx->slice.active, 1);
+    assert_int_equal(ctx->slice.synced, 1);
+
+    rdsparser_slice_reset(&ctx->slice);
+    assert_int_equal(ctx->slice.synced, 0);
+    assert_false(rdsparser_sync_get_synced(rdsparser_slice_get_lane(&ctx->slice, 0)));
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test_setup(slice_test_syndrome, test_setup),
+    cmocka_unit_test_setup(slice_test_lanes, test_setup),
+    cmocka_unit_test_setup(slice_test_detach, test_setup)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, group_setup, group_teardown);
+}
@@ -0,0 +1,195 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "snapshot.c"
+
+static const char *test_groups[] =
+{
+    "34DB051E20202020",
+    "34DB0019524144494F",
+    "34DB2540546573742000",
+    "34DB2541206F6E652000",
+    "34DB100000E20000",
+    "34DBA5505241444900",
+    "3F444541D7500580"
+};
+
+typedef struct {
+    rdsparser_t rds;
+    rdsparser_t restored;
+    uint8_t buffer[1024];
+} test_context_t;
+
+static int
+group_setup(void **state)
+{
+    test_context_t *ctx = calloc(sizeof(test_context_t), 1);
+    *state = ctx;
+    return 0;
+}
+
+static int
+group_teardown(void **state)
+{
+    test_context_t *ctx = *state;
+    free(ctx);
+    return 0;
+}
+
+static int
+test_setup(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_init(&ctx->rds);
+    rdsparser_init(&ctx->restored);
+    rdsparser_set_extended_check(&ctx->rds, true);
+    rdsparser_set_voting(&ctx->rds, RDSPARSER_FEATURE_TA | RDSPARSER_FEATURE_MS, 5, 4);
+    rdsparser_set_text_progressive(&ctx->rds, RDSPARSER_TEXT_RT, true);
+    rdsparser_set_text_correction(&ctx->rds, RDSPARSER_TEXT_PS, RDSPARSER_BLOCK_TYPE_DATA, RDSPARSER_BLOCK_ERROR_LARGE);
+
+    for (size_t i = 0; i < sizeof(test_groups) / sizeof(test_groups[0]); i++)
+    {
+        rdsparser_parse_string(&ctx->rds, test_groups[i]);
+    }
+    rdsparser_set_station_change(&ctx->rds, 3);
+
+    return 0;
+}
+
+static void
+snapshot_test_assert_string(const rdsparser_string_t *expected,
+                            const rdsparser_string_t *actual)
+{
+    assert_int_equal(rdsparser_string_get_length(actual), rdsparser_string_get_length(expected));
+    assert_int_equal(rdsparser_string_get_table(actual), rdsparser_string_get_table(expected));
+    for (uint8_t i = 0; i < rdsparser_string_get_length(expected); i++)
+    {
+        assert_int_equal(rdsparser_string_get_content(actual)[i], rdsparser_string_get_content(expected)[i]);
+        assert_int_equal(rdsparser_string_get_errors(actual)[i], rdsparser_string_get_errors(expected)[i]);
+    }
+}
+
+static void
+snapshot_test_roundtrip(void **state)
+{
+    test_context_t *ctx = *state;
+    const size_t size = rdsparser_snapshot_size();
+
+    assert_true(size <= sizeof(ctx->buffer));
+    assert_int_equal(rdsparser_snapshot_save(&ctx->rds, ctx->buffer, sizeof(ctx->buffer)), size);
+    /* A pending station change is not carried over */
+    ctx->restored.station_pi = 0x4321;
+    ctx->restored.station_count = 2;
+    assert_true(rdsparser_snapshot_load(&ctx->restored, ctx->buffer, size));
+    assert_int_equal(ctx->restored.station_pi, RDSPARSER_PI_UNKNOWN);
+    assert_int_equal(ctx->restored.station_count, 0);
+
+    assert_int_equal(rdsparser_get_pi(&ctx->restored), rdsparser_get_pi(&ctx->rds));
+    assert_int_equal(rdsparser_get_pty(&ctx->restored), rdsparser_get_pty(&ctx->rds));
+    assert_int_equal(rdsparser_get_tp(&ctx->restored), rdsparser_get_tp(&ctx->rds));
+    assert_int_equal(rdsparser_get_ta(&ctx->restored), rdsparser_get_ta(&ctx->rds));
+    assert_int_equal(rdsparser_get_ms(&ctx->restored), rdsparser_get_ms(&ctx->rds));
+    assert_int_equal(rdsparser_get_ecc(&ctx->restored), rdsparser_get_ecc(&ctx->rds));
+    assert_int_equal(rdsparser_get_country(&ctx->restored), rdsparser_get_country(&ctx->rds));
+    assert_memory_equal(rdsparser_get_af(&ctx->restored), rdsparser_get_af(&ctx->rds), sizeof(rdsparser_af_t));
+    /* The voting history is not stored */
+    assert_memory_equal(&ctx->restored.buffer.data_used, &ctx->rds.buffer.data_used, sizeof(rdsparser_buffer_data_t));
+    assert_memory_equal(&ctx->restored.buffer.data_temp, &ctx->rds.buffer.data_temp, sizeof(rdsparser_buffer_data_t));
+    assert_int_equal(ctx->restored.last_rt_flag, ctx->rds.last_rt_flag);
+    assert_true(rdsparser_get_extended_check(&ctx->restored));
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->restored, RDSPARSER_FEATURE_TA), 5);
+    assert_int_equal(rdsparser_get_voting_window(&ctx->restored, RDSPARSER_FEATURE_MS), 4);
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->restored, RDSPARSER_FEATURE_PI), 0);
+    assert_int_equal(rdsparser_get_station_change(&ctx->restored), 3);
+    assert_true(rdsparser_get_text_progressive(&ctx->restored, RDSPARSER_TEXT_RT));
+    assert_int_equal(rdsparser_get_text_correction(&ctx->restored, RDSPARSER_TEXT_PS, RDSPARSER_BLOCK_TYPE_DATA), RDSPARSER_BLOCK_ERROR_LARGE);
+    assert_non_null(rdsparser_get_ct(&ctx->restored));
+    assert_int_equal(rdsparser_ct_get_minute(rdsparser_get_ct(&ctx->restored)), rdsparser_ct_get_minute(rdsparser_get_ct(&ctx->rds)));
+    assert_int_equal(rdsparser_ct_get_offset(rdsparser_get_ct(&ctx->restored)), rdsparser_ct_get_offset(rdsparser_get_ct(&ctx->rds)));
+
+    snapshot_test_assert_string(rdsparser_get_ps(&ctx->rds), rdsparser_get_ps(&ctx->restored));
+    snapshot_test_assert_string(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), rdsparser_get_rt(&ctx->restored, RDSPARSER_RT_FLAG_A));
+    snapshot_test_assert_string(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B), rdsparser_get_rt(&ctx->restored, RDSPARSER_RT_FLAG_B));
+    snapshot_test_assert_string(rdsparser_get_ptyn(&ctx->rds), rdsparser_get_ptyn(&ctx->restored));
+
+    /* Both contexts continue in the same way */
+    rdsparser_parse_string(&ctx->rds, "34DB2542626F6F6B00");
+    rdsparser_parse_string(&ctx->restored, "34DB2542626F6F6B00");
+    snapshot_test_assert_string(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), rdsparser_get_rt(&ctx->restored, RDSPARSER_RT_FLAG_A));
+}
+
+static void
+snapshot_test_layout(void **state)
+{
+    test_context_t *ctx = *state;
+
+    assert_int_equal(rdsparser_snapshot_save(&ctx->rds, ctx->buffer, sizeof(ctx->buffer)), rdsparser_snapshot_size());
+    assert_memory_equal(ctx->buffer, "RDSS\x02\x00\x00\x00", 8);
+
+    /* PI of the used data, little-endian */
+    assert_int_equal(ctx->buffer[8], 0xDB);
+    assert_int_equal(ctx->buffer[9], 0x34);
+    assert_int_equal(ctx->buffer[10], 0x00);
+    assert_int_equal(ctx->buffer[11], 0x00);
+}
+
+static void
+snapshot_test_invalid(void **state)
+{
+    test_context_t *ctx = *state;
+    const size_t size = rdsparser_snapshot_size();
+
+    assert_int_equal(rdsparser_snapshot_save(&ctx->rds, ctx->buffer, size - 1), 0);
+    assert_int_equal(rdsparser_snapshot_save(&ctx->rds, ctx->buffer, size), size);
+    assert_false(rdsparser_snapshot_load(&ctx->restored, ctx->buffer, size - 1));
+
+    ctx->buffer[4] = RDSPARSER_SNAPSHOT_VERSION + 1;
+    assert_false(rdsparser_snapshot_load(&ctx->restored, ctx->buffer, size));
+    ctx->buffer[4] = RDSPARSER_SNAPSHOT_VERSION;
+    ctx->buffer[0] = 'X';
+    assert_false(rdsparser_snapshot_load(&ctx->restored, ctx->buffer, size));
+
+    /* Nothing was restored */
+    assert_int_equal(rdsparser_get_pi(&ctx->restored), RDSPARSER_PI_UNKNOWN);
+
+    /* Threshold that can never be reached disables the voting */
+    ctx->rds.buffer.vote[RDSPARSER_BUFFER_FIELD_TA].threshold = 13;
+    assert_int_equal(rdsparser_snapshot_save(&ctx->rds, ctx->buffer, size), size);
+    assert_true(rdsparser_snapshot_load(&ctx->restored, ctx->buffer, size));
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->restored, RDSPARSER_FEATURE_TA), 0);
+    assert_int_equal(rdsparser_get_voting_threshold(&ctx->restored, RDSPARSER_FEATURE_MS), 5);
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test_setup(snapshot_test_roundtrip, test_setup),
+    cmocka_unit_test_setup(snapshot_test_layout, test_setup),
+    cmocka_unit_test_setup(snapshot_test_invalid, test_setup)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, group_setup, group_teardown);
+}
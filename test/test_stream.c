@@ -0,0 +1,142 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2023  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <librdsparser_private.h>
+
+typedef struct {
+    rdsparser_t rds;
+    rdsparser_stream_t stream;
+} test_context_t;
+
+static int
+group_setup(void **state)
+{
+    test_context_t *ctx = calloc(sizeof(test_context_t), 1);
+    *state = ctx;
+    return 0;
+}
+
+static int
+group_teardown(void **state)
+{
+    test_context_t *ctx = *state;
+    free(ctx);
+    return 0;
+}
+
+static int
+test_setup(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_init(&ctx->rds);
+    rdsparser_stream_init(&ctx->stream, &ctx->rds);
+    return 0;
+}
+
+static int
+test_teardown(void **state)
+{
+    test_context_t *ctx = *state;
+    (void)ctx;
+    return 0;
+}
+
+static void
+stream_test_complete_lines(void **state)
+{
+    test_context_t *ctx = *state;
+    static const char input[] = "1234567890123458\nA201200220D7313A00\r\n";
+
+    assert_int_equal(rdsparser_stream_feed(&ctx->stream, input, sizeof(input) - 1), 2);
+    assert_int_equal(rdsparser_stream_get_parsed(&ctx->stream), 2);
+    assert_int_equal(rdsparser_stream_get_invalid(&ctx->stream), 0);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0xA201);
+}
+
+static void
+stream_test_partial_lines(void **state)
+{
+    test_context_t *ctx = *state;
+    static const char input[] = "1234567890123458\nA201200220D7313A00\n3566100000E20000\n";
+    const size_t length = sizeof(input) - 1;
+    size_t parsed = 0;
+
+    /* Feed byte by byte */
+    for (size_t i = 0; i < length; i++)
+    {
+        parsed += rdsparser_stream_feed(&ctx->stream, input + i, 1);
+        if (i == 16)
+        {
+            assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x1234);
+        }
+    }
+
+    assert_int_equal(parsed, 3);
+    assert_int_equal(rdsparser_stream_get_invalid(&ctx->stream), 0);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x3566);
+}
+
+static void
+stream_test_invalid_lines(void **state)
+{
+    test_context_t *ctx = *state;
+    static const char input[] = "12345678901234\n"
+                        "X234567890123458\n"
+                        "\n"
+                        "1234567890123458123456789012345812345678901234581234567890123458\n"
+                        "A201200220D7313A00\n";
+
+    assert_int_equal(rdsparser_stream_feed(&ctx->stream, input, 20), 0);
+    assert_int_equal(rdsparser_stream_feed(&ctx->stream, input + 20, 30), 0);
+    assert_int_equal(rdsparser_stream_feed(&ctx->stream, input + 50, sizeof(input) - 1 - 50), 1);
+    assert_int_equal(rdsparser_stream_get_parsed(&ctx->stream), 1);
+    assert_int_equal(rdsparser_stream_get_invalid(&ctx->stream), 3);
+}
+
+static void
+stream_test_flush(void **state)
+{
+    test_context_t *ctx = *state;
+    static const char input[] = "1234567890123458\nA201200220D7313A00";
+
+    assert_int_equal(rdsparser_stream_feed(&ctx->stream, input, sizeof(input) - 1), 1);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x1234);
+    assert_int_equal(rdsparser_stream_flush(&ctx->stream), 1);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0xA201);
+    assert_int_equal(rdsparser_stream_flush(&ctx->stream), 0);
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test_setup_teardown(stream_test_complete_lines, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(stream_test_partial_lines, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(stream_test_invalid_lines, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(stream_test_flush, test_setup, test_teardown)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, group_setup, group_teardown);
+}
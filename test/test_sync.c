@@ -0,0 +1,259 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2024  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "sync.c"
+
+#define TEST_SYNC_GROUPS 8
+#define TEST_SYNC_PREFIX 11
+#define TEST_SYNC_GROUP_BITS (RDSPARSER_BLOCK_COUNT * RDSPARSER_SYNC_BLOCK_BITS)
+#define TEST_SYNC_BITS (TEST_SYNC_PREFIX + TEST_SYNC_GROUPS * TEST_SYNC_GROUP_BITS)
+
+/* PS "Test PS!" in groups 0A */
+static const rdsparser_data_t sync_test_groups[] =
+{
+    { 0x3566, 0x0400, 0xE20D, 0x5465 },
+    { 0x3566, 0x0401, 0xE20D, 0x7374 },
+    { 0x3566, 0x0402, 0xE20D, 0x2050 },
+    { 0x3566, 0x0403, 0xE20D, 0x5321 }
+};
+
+typedef struct {
+    rdsparser_t rds;
+    rdsparser_sync_t sync;
+    uint8_t bits[TEST_SYNC_BITS];
+} test_context_t;
+
+static void
+sync_test_encode(uint8_t  *output,
+                 uint16_t  info,
+                 uint16_t  offset)
+{
+    const uint32_t block = ((uint32_t)info << 10) | (rdsparser_sync_checkword(info) ^ offset);
+    for (uint8_t i = 0; i < RDSPARSER_SYNC_BLOCK_BITS; i++)
+    {
+        output[i] = (block >> (RDSPARSER_SYNC_BLOCK_BITS - 1 - i)) & 1;
+    }
+}
+
+static void
+sync_test_build(uint8_t *output)
+{
+    static const uint16_t offsets[] = { RDSPARSER_SYNC_OFFSET_A, RDSPARSER_SYNC_OFFSET_B, RDSPARSER_SYNC_OFFSET_C, RDSPARSER_SYNC_OFFSET_D };
+
+    for (size_t i = 0; i < TEST_SYNC_PREFIX; i++)
+    {
+        output[i] = (uint8_t)(i & 1);
+    }
+
+    for (size_t g = 0; g < TEST_SYNC_GROUPS; g++)
+    {
+        const uint16_t *group = sync_test_groups[g % 4];
+        for (uint8_t block = 0; block < RDSPARSER_BLOCK_COUNT; block++)
+        {
+            sync_test_encode(output + TEST_SYNC_PREFIX + g * TEST_SYNC_GROUP_BITS + block * RDSPARSER_SYNC_BLOCK_BITS,
+                             group[block], offsets[block]);
+        }
+    }
+}
+
+static uint8_t*
+sync_test_block(uint8_t *bits,
+                size_t   group,
+                uint8_t  block)
+{
+    return bits + TEST_SYNC_PREFIX + group * TEST_SYNC_GROUP_BITS + block * RDSPARSER_SYNC_BLOCK_BITS;
+}
+
+static void
+sync_test_ps(const rdsparser_t *rds,
+             const char        *expected)
+{
+    const rdsparser_string_char_t *content = rdsparser_string_get_content(rdsparser_get_ps(rds));
+    for (uint8_t i = 0; i < RDSPARSER_PS_LENGTH; i++)
+    {
+        assert_int_equal(content[i], expected[i]);
+    }
+}
+
+static int
+group_setup(void **state)
+{
+    test_context_t *ctx = calloc(sizeof(test_context_t), 1);
+    *state = ctx;
+    return 0;
+}
+
+static int
+group_teardown(void **state)
+{
+    test_context_t *ctx = *state;
+    free(ctx);
+    return 0;
+}
+
+static int
+test_setup(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_init(&ctx->rds);
+    rdsparser_sync_init(&ctx->sync, &ctx->rds);
+    sync_test_build(ctx->bits);
+    return 0;
+}
+
+static void
+sync_test_syndrome(void **state)
+{
+    (void)state;
+    uint16_t data;
+
+    for (uint32_t info = 0; info <= 0xFFFF; info += 0x1111)
+    {
+        const uint32_t block = (info << 10) | (rdsparser_sync_checkword((uint16_t)info) ^ RDSPARSER_SYNC_OFFSET_B);
+        const uint16_t syndrome = rdsparser_sync_syndrome(block);
+        assert_int_equal(syndrome, RDSPARSER_SYNC_OFFSET_B);
+        assert_int_equal(rdsparser_sync_correct(block, syndrome ^ RDSPARSER_SYNC_OFFSET_B, &data), RDSPARSER_BLOCK_ERROR_NONE);
+        assert_int_equal(data, info);
+    }
+}
+
+static void
+sync_test_correct(void **state)
+{
+    (void)state;
+    const uint16_t info = 0xA201;
+    const uint32_t block = ((uint32_t)info << 10) | (rdsparser_sync_checkword(info) ^ RDSPARSER_SYNC_OFFSET_A);
+    uint16_t data;
+
+    /* Single bit anywhere */
+    for (uint8_t i = 0; i < RDSPARSER_SYNC_BLOCK_BITS; i++)
+    {
+        const uint32_t received = block ^ (1UL << i);
+        assert_int_equal(rdsparser_sync_correct(received, rdsparser_sync_syndrome(received) ^ RDSPARSER_SYNC_OFFSET_A, &data), RDSPARSER_BLOCK_ERROR_SMALL);
+        assert_int_equal(data, info);
+    }
+
+    /* 5-bit burst */
+    uint32_t received = block ^ (0x1DUL << 15);
+    assert_int_equal(rdsparser_sync_correct(received, rdsparser_sync_syndrome(received) ^ RDSPARSER_SYNC_OFFSET_A, &data), RDSPARSER_BLOCK_ERROR_LARGE);
+    assert_int_equal(data, info);
+
+    /* Two distant bits */
+    received = block ^ (1UL << 3) ^ (1UL << 20);
+    assert_int_equal(rdsparser_sync_correct(received, rdsparser_sync_syndrome(received) ^ RDSPARSER_SYNC_OFFSET_A, &data), RDSPARSER_BLOCK_ERROR_UNCORRECTABLE);
+}
+
+static void
+sync_test_acquire(void **state)
+{
+    test_context_t *ctx = *state;
+
+    const size_t groups = rdsparser_sync_feed_bits(&ctx->sync, ctx->bits, TEST_SYNC_BITS);
+
+    assert_true(rdsparser_sync_get_synced(&ctx->sync));
+    /* Two blocks are needed to acquire synchronization */
+    assert_int_equal(groups, TEST_SYNC_GROUPS);
+    assert_int_equal(rdsparser_sync_get_groups(&ctx->sync), TEST_SYNC_GROUPS);
+    assert_int_equal(rdsparser_sync_get_corrected(&ctx->sync), 0);
+    assert_int_equal(rdsparser_sync_get_uncorrectable(&ctx->sync), 0);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x3566);
+    sync_test_ps(&ctx->rds, "Test PS!");
+}
+
+static void
+sync_test_packed(void **state)
+{
+    test_context_t *ctx = *state;
+    uint8_t packed[(TEST_SYNC_BITS + 7) / 8] = { 0 };
+
+    for (size_t i = 0; i < TEST_SYNC_BITS; i++)
+    {
+        packed[i / 8] |= (uint8_t)(ctx->bits[i] << (7 - i % 8));
+    }
+
+    assert_int_equal(rdsparser_sync_feed(&ctx->sync, packed, TEST_SYNC_BITS), TEST_SYNC_GROUPS);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x3566);
+}
+
+static void
+sync_test_errors(void **state)
+{
+    test_context_t *ctx = *state;
+
+    /* Single bit error in block D of the 3rd group and a burst in block B of the 4th */
+    sync_test_block(ctx->bits, 2, RDSPARSER_BLOCK_D)[4] ^= 1;
+    sync_test_block(ctx->bits, 3, RDSPARSER_BLOCK_B)[10] ^= 1;
+    sync_test_block(ctx->bits, 3, RDSPARSER_BLOCK_B)[12] ^= 1;
+    sync_test_block(ctx->bits, 3, RDSPARSER_BLOCK_B)[13] ^= 1;
+    /* Uncorrectable block C of the 5th group */
+    sync_test_block(ctx->bits, 4, RDSPARSER_BLOCK_C)[0] ^= 1;
+    sync_test_block(ctx->bits, 4, RDSPARSER_BLOCK_C)[20] ^= 1;
+
+    rdsparser_sync_feed_bits(&ctx->sync, ctx->bits, TEST_SYNC_BITS);
+
+    assert_true(rdsparser_sync_get_synced(&ctx->sync));
+    assert_int_equal(rdsparser_sync_get_groups(&ctx->sync), TEST_SYNC_GROUPS);
+    assert_int_equal(rdsparser_sync_get_corrected(&ctx->sync), 2);
+    assert_int_equal(rdsparser_sync_get_uncorrectable(&ctx->sync), 1);
+    sync_test_ps(&ctx->rds, "Test PS!");
+}
+
+static void
+sync_test_loss(void **state)
+{
+    test_context_t *ctx = *state;
+    uint8_t slipped[RDSPARSER_SYNC_BLOCK_BITS * RDSPARSER_SYNC_LOSS_BLOCKS];
+
+    rdsparser_sync_feed_bits(&ctx->sync, ctx->bits, TEST_SYNC_BITS);
+    assert_true(rdsparser_sync_get_synced(&ctx->sync));
+
+    /* Shift the stream by a single bit */
+    for (size_t i = 0; i < sizeof(slipped); i++)
+    {
+        slipped[i] = ctx->bits[TEST_SYNC_PREFIX + 1 + i];
+    }
+
+    rdsparser_sync_feed_bits(&ctx->sync, slipped, sizeof(slipped));
+    assert_false(rdsparser_sync_get_synced(&ctx->sync));
+
+    /* ...and recover */
+    rdsparser_sync_feed_bits(&ctx->sync, ctx->bits + TEST_SYNC_PREFIX, TEST_SYNC_BITS - TEST_SYNC_PREFIX);
+    assert_true(rdsparser_sync_get_synced(&ctx->sync));
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test(sync_test_syndrome),
+    cmocka_unit_test(sync_test_correct),
+    cmocka_unit_test_setup(sync_test_acquire, test_setup),
+    cmocka_unit_test_setup(sync_test_packed, test_setup),
+    cmocka_unit_test_setup(sync_test_errors, test_setup),
+    cmocka_unit_test_setup(sync_test_loss, test_setup)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, group_setup, group_teardown);
+}
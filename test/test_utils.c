@@ -0,0 +1,105 @@
+/*  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  librdsparser – Radio Data System parser library
+ *  Copyright (C) 2023  Konrad Kosmatka
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "utils.c"
+
+static void
+utils_test_convert_no_errors(void **state)
+{
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    assert_int_equal(rdsparser_utils_convert("34DB054AE3054F20", data, errors), true);
+    assert_int_equal(data[0], 0x34DB);
+    assert_int_equal(data[1], 0x054A);
+    assert_int_equal(data[2], 0xE305);
+    assert_int_equal(data[3], 0x4F20);
+    assert_int_equal(errors[0], 0);
+    assert_int_equal(errors[1], 0);
+    assert_int_equal(errors[2], 0);
+    assert_int_equal(errors[3], 0);
+}
+
+static void
+utils_test_convert_errors(void **state)
+{
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    assert_int_equal(rdsparser_utils_convert("34db054ae3054f201B", data, errors), true);
+    assert_int_equal(data[0], 0x34DB);
+    assert_int_equal(data[1], 0x054A);
+    assert_int_equal(data[2], 0xE305);
+    assert_int_equal(data[3], 0x4F20);
+    assert_int_equal(errors[0], 0);
+    assert_int_equal(errors[1], 1);
+    assert_int_equal(errors[2], 2);
+    assert_int_equal(errors[3], 3);
+}
+
+static void
+utils_test_convert_invalid(void **state)
+{
+    rdsparser_data_t data = { 1, 2, 3, 4 };
+    rdsparser_error_t errors;
+
+    assert_int_equal(rdsparser_utils_convert("+234567890123456", data, errors), false);
+    assert_int_equal(rdsparser_utils_convert(" 234567890123456", data, errors), false);
+    assert_int_equal(rdsparser_utils_convert("0x34567890123456", data, errors), false);
+    assert_int_equal(rdsparser_utils_convert("123456789012345G", data, errors), false);
+    assert_int_equal(rdsparser_utils_convert("12345678901234\xC1" "6", data, errors), false);
+    assert_int_equal(rdsparser_utils_convert("12345678901234561-", data, errors), false);
+    assert_int_equal(data[0], 1);
+    assert_int_equal(data[3], 4);
+}
+
+static void
+utils_test_convert_n(void **state)
+{
+    const char line[] = "A201200220D7313A00\nA201";
+    rdsparser_data_t data;
+    rdsparser_error_t errors;
+
+    assert_int_equal(rdsparser_utils_convert_n(line, 18, data, errors), true);
+    assert_int_equal(data[0], 0xA201);
+    assert_int_equal(data[3], 0x313A);
+    assert_int_equal(rdsparser_utils_convert_n(line, 16, data, errors), true);
+    assert_int_equal(rdsparser_utils_convert_n(line, 17, data, errors), false);
+    assert_int_equal(rdsparser_utils_convert_n(line, 19, data, errors), false);
+    assert_int_equal(rdsparser_utils_convert_n(line, 0, data, errors), false);
+}
+
+const struct CMUnitTest tests[] =
+{
+    cmocka_unit_test_setup_teardown(utils_test_convert_no_errors, NULL, NULL),
+    cmocka_unit_test_setup_teardown(utils_test_convert_errors, NULL, NULL),
+    cmocka_unit_test_setup_teardown(utils_test_convert_invalid, NULL, NULL),
+    cmocka_unit_test_setup_teardown(utils_test_convert_n, NULL, NULL)
+};
+
+int
+main(void)
+{
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -162,8 +162,7 @@ callback_ps(rdsparser_t *rds,
 {
     test_context_t *ctx = (test_context_t*)user_data;
     const rdsparser_string_t *string = rdsparser_get_ps(rds);
-    const rdsparser_string_char_t *content = rdsparser_string_get_content(string);
-    assert_rds_string_equal(content, ctx->ps);
+    assert_rds_string_equal(string, ctx->ps);
     function_called();
 }
 
@@ -174,8 +173,7 @@ callback_rt(rdsparser_t         *rds,
 {
     test_context_t *ctx = (test_context_t*)user_data;
     const rdsparser_string_t *string = rdsparser_get_rt(rds, flag);
-    const rdsparser_string_char_t *content = rdsparser_string_get_content(string);
-    assert_rds_string_equal(content, ctx->rt[flag]);
+    assert_rds_string_equal(string, ctx->rt[flag]);
     function_called();
 }
 
@@ -185,8 +183,7 @@ callback_ptyn(rdsparser_t *rds,
 {
     test_context_t *ctx = (test_context_t*)user_data;
     const rdsparser_string_t *string = rdsparser_get_ptyn(rds);
-    const rdsparser_string_char_t *content = rdsparser_string_get_content(string);
-    assert_rds_string_equal(content, ctx->ptyn);
+    assert_rds_string_equal(string, ctx->ptyn);
     function_called();
 }
 
@@ -246,6 +243,122 @@ verification_pi_extended_check(void **state)
     verification_pi(state);
 }
 
+static void
+verification_pi_c(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_register_pi(&ctx->rds, callback_pi);
+    ctx->pi = 0x1234;
+
+    /* Version A, block C is not a PI */
+    expect_function_call(callback_pi);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234000043212020"), true);
+    rdsparser_clear(&ctx->rds);
+
+    /* Version B, PI from block C' only */
+    expect_function_call(callback_pi);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321080012342020C0"), true);
+    rdsparser_clear(&ctx->rds);
+
+    /* Version bit of a corrected block B is not trusted */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321080012342020D0"), true);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), RDSPARSER_PI_UNKNOWN);
+    rdsparser_clear(&ctx->rds);
+
+    /* Mismatching copies */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234080043212020"), true);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), RDSPARSER_PI_UNKNOWN);
+}
+
+static void
+verification_pi_c_extended_check(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_register_pi(&ctx->rds, callback_pi);
+    rdsparser_set_extended_check(&ctx->rds, true);
+    ctx->pi = 0x1234;
+
+    /* Both copies confirm the PI in a single group */
+    expect_function_call(callback_pi);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234080012342020"), true);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x1234);
+}
+
+static void
+verification_pi_voting(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_register_pi(&ctx->rds, callback_pi);
+    assert_int_equal(rdsparser_set_voting(&ctx->rds, RDSPARSER_FEATURE_PI, 5, 4), true);
+    ctx->pi = 0x1234;
+
+    /* Corrected block A is counted with a lower weight */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "123456789012345840"), true);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), RDSPARSER_PI_UNKNOWN);
+    expect_function_call(callback_pi);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234567890123458"), true);
+
+    /* Uncorrectable blocks are never counted */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321567890123458C0"), true);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321567890123458C0"), true);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x1234);
+}
+
+static void
+verification_pi_station_change(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_register_pi(&ctx->rds, callback_pi);
+    rdsparser_set_station_change(&ctx->rds, 3);
+
+    ctx->pi = 0x1234;
+    expect_function_call(callback_pi);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234054C01203A3B"), true);
+
+    /* Interrupted by the current station */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321054C01204142"), true);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234054901203C3D"), true);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321054C01204142"), true);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321054C01204142"), true);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x1234);
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L":;<=    ");
+
+    /* Without a reliable PI, not assigned to either station */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234054A01203E3FC0"), true);
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L":;<=    ");
+
+    /* Confirmed, nothing from the previous station is left */
+    ctx->pi = 0x4321;
+    expect_function_call(callback_pi);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321054C01204142"), true);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x4321);
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L"AB      ");
+}
+
+static void
+verification_pi_station_change_reset(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_register_af(&ctx->rds, callback_af);
+    rdsparser_register_ps(&ctx->rds, callback_ps);
+    rdsparser_set_station_change(&ctx->rds, 2);
+
+    swprintf(ctx->ps, sizeof(ctx->ps), L":;      ");
+    expect_function_call(callback_ps);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "12340D4C12343A3B"), true);
+    rdsparser_poll_changes(&ctx->rds);
+
+    /* Confirmed by an RT group, the cleared PS and AF list are reported */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321254041424344"), true);
+    swprintf(ctx->ps, sizeof(ctx->ps), L"        ");
+    ctx->af1 = 0;
+    expect_function_call(callback_af);
+    expect_function_call(callback_ps);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "4321254041424344"), true);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x4321);
+    assert_int_equal(rdsparser_poll_changes(&ctx->rds), RDSPARSER_CHANGE_ALL);
+}
+
 static void
 verification_pty(void **state)
 {
@@ -391,6 +504,54 @@ verification_ta_extended_check(void **state)
     verification_ta_true(state);
 }
 
+static void
+verification_ta_15b(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_register_ta(&ctx->rds, callback_ta);
+
+    expect_function_call(callback_ta);
+    ctx->ta = 1;
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234FC181234FC18"), true);
+    rdsparser_clear(&ctx->rds);
+
+    /* Block B only, block D is uncorrectable */
+    expect_function_call(callback_ta);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234FC181234FC0803"), true);
+    rdsparser_clear(&ctx->rds);
+
+    /* Block D only, corrected block B is not used by default */
+    expect_function_call(callback_ta);
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234FC081234FC1810"), true);
+    rdsparser_clear(&ctx->rds);
+
+    /* Mismatching copies */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234FC181234FC08"), true);
+    assert_int_equal(rdsparser_get_ta(&ctx->rds), RDSPARSER_TA_UNKNOWN);
+    assert_int_equal(rdsparser_get_ms(&ctx->rds), RDSPARSER_MS_UNKNOWN);
+
+    /* PTY and TP of the block B are not used either */
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234FC181234FDB8"), true);
+    assert_int_equal(rdsparser_get_pty(&ctx->rds), RDSPARSER_PTY_UNKNOWN);
+    assert_int_equal(rdsparser_get_tp(&ctx->rds), RDSPARSER_TP_UNKNOWN);
+    assert_int_equal(rdsparser_get_pi(&ctx->rds), 0x1234);
+}
+
+static void
+verification_ta_15b_extended_check(void **state)
+{
+    test_context_t *ctx = *state;
+    rdsparser_register_ta(&ctx->rds, callback_ta);
+    rdsparser_set_extended_check(&ctx->rds, true);
+
+    /* Both copies confirm the TA in a single group */
+    expect_function_call(callback_ta);
+    ctx->ta = 1;
+    assert_int_equal(rdsparser_parse_string(&ctx->rds, "1234FC181234FC18"), true);
+    assert_int_equal(rdsparser_get_tp(&ctx->rds), 1);
+    assert_int_equal(rdsparser_get_ms(&ctx->rds), 1);
+}
+
 static void
 verification_ms_true(void **state)
 {
@@ -620,7 +781,7 @@ verification_ps(void **state)
     check_ps(ctx, "1234054F01204AF2", L":;<=>?Jæ");
 
     rdsparser_clear(&ctx->rds);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_ps(&ctx->rds)), L"        ");
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L"        ");
 }
 
 static void
@@ -638,7 +799,7 @@ verification_ps_invalid(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD09833D9D4449FF"), true); /* "      DI" */
 
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_ps(&ctx->rds)), false);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_ps(&ctx->rds)), L"        ");
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L"        ");
 }
 
 static void
@@ -655,7 +816,7 @@ verification_ps_invalid_pos(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD054AE3054F2030"), true); /* "    O   " */
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD09833D9D444930"), true); /* "      DI" */
 
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_ps(&ctx->rds)), L"        ");
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L"        ");
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_ps(&ctx->rds)), false);
 }
 
@@ -673,7 +834,7 @@ verification_ps_invalid_data(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD054AE3054F2003"), true); /* "    O   " */
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD09833D9D444903"), true); /* "      DI" */
 
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_ps(&ctx->rds)), L"        ");
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L"        ");
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_ps(&ctx->rds)), false);
 }
 
@@ -697,7 +858,7 @@ verification_ps_with_small_errors(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD054F2182372000"), true); /* "      7 " */
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD09833D9D444901"), true); /* "      DI" */
 
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_ps(&ctx->rds)), L"RADIO DI");
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L"RADIO DI");
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_ps(&ctx->rds)), true);
 }
 
@@ -721,7 +882,7 @@ verification_ps_with_large_errors(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD054F2182372000"), true); /* "      7 " */
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD09833D9D444901"), true); /* "      DI" */
 
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_ps(&ctx->rds)), L"O5DIO DI");
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L"O5DIO DI");
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_ps(&ctx->rds)), true);
 }
 
@@ -746,7 +907,7 @@ verification_ps_progressive(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD054F2182372000"), true); /* "      7 " */
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DD09833D9D444901"), true); /* "      DI" */
 
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_ps(&ctx->rds)), L"RADIO 7 ");
+    assert_rds_string_equal(rdsparser_get_ps(&ctx->rds), L"RADIO 7 ");
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_ps(&ctx->rds)), true);
 }
 
@@ -789,11 +950,11 @@ verification_rt_a(void **state)
     check_rt(ctx, "34DB254E3634203600", L"KRDP Plock ul. Tumska 3 (I pietro) Tel do redakcji: 24 264 6    ", RDSPARSER_RT_FLAG_A);
     check_rt(ctx, "34DB254F3420303000", L"KRDP Plock ul. Tumska 3 (I pietro) Tel do redakcji: 24 264 64 00", RDSPARSER_RT_FLAG_A);
 
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B)), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B), empty);
 
     rdsparser_clear(&ctx->rds);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), empty);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B)), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B), empty);
 }
 
 static void
@@ -820,11 +981,11 @@ verification_rt_b(void **state)
     check_rt(ctx, "34DB255E3634203600", L"KRDP Plock ul. Tumska 3 (I pietro) Tel do redakcji: 24 264 6    ", RDSPARSER_RT_FLAG_B);
     check_rt(ctx, "34DB255F3420303000", L"KRDP Plock ul. Tumska 3 (I pietro) Tel do redakcji: 24 264 64 00", RDSPARSER_RT_FLAG_B);
 
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), empty);
 
     rdsparser_clear(&ctx->rds);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), empty);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B)), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_B), empty);
 }
 
 static void
@@ -855,7 +1016,7 @@ verification_rt_invalid(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DB254F34203030FF"), true);
 
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), false);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), empty);
 }
 
 static void
@@ -886,7 +1047,7 @@ verification_rt_invalid_pos(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DB254F3420303030"), true);
 
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), false);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), empty);
 }
 
 static void
@@ -917,7 +1078,7 @@ verification_rt_invalid_data(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DB254F342030300F"), true);
 
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), false);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), empty);
 }
 
 static void
@@ -931,7 +1092,7 @@ verification_rt_empty(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DB25000D202020"), true);
 
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), true);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), L"");
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), L"");
 }
 
 static void
@@ -944,7 +1105,7 @@ verification_rt_empty_with_error(void **state)
     assert_int_equal(rdsparser_parse_string(&ctx->rds, "34DB25000D20202010"), true);
 
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), false);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A)), empty);
+    assert_rds_string_equal(rdsparser_get_rt(&ctx->rds, RDSPARSER_RT_FLAG_A), empty);
 }
 
 static void
@@ -968,7 +1129,7 @@ verification_ptyn(void **state)
     assert_int_equal(rdsparser_string_get_available(rdsparser_get_ptyn(&ctx->rds)), true);
 
     rdsparser_clear(&ctx->rds);
-    assert_rds_string_equal(rdsparser_string_get_content(rdsparser_get_ptyn(&ctx->rds)), L"        ");
+    assert_rds_string_equal(rdsparser_get_ptyn(&ctx->rds), L"        ");
 }
 
 static void
@@ -993,6 +1154,11 @@ const struct CMUnitTest tests[] =
     cmocka_unit_test_setup_teardown(verification_pi, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_pi_invalid, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_pi_extended_check, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(verification_pi_c, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(verification_pi_c_extended_check, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(verification_pi_voting, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(verification_pi_station_change, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(verification_pi_station_change_reset, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_pty, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_pty_invalid, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_pty_extended_check, test_setup, test_teardown),
@@ -1004,6 +1170,8 @@ const struct CMUnitTest tests[] =
     cmocka_unit_test_setup_teardown(verification_ta_false, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_ta_invalid, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_ta_extended_check, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(verification_ta_15b, test_setup, test_teardown),
+    cmocka_unit_test_setup_teardown(verification_ta_15b_extended_check, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_ms_true, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_ms_false, test_setup, test_teardown),
     cmocka_unit_test_setup_teardown(verification_ms_invalid, test_setup, test_teardown),